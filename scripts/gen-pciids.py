@@ -58,6 +58,11 @@ typedef struct FFPciVendor
     if keep_vendor_list:
         vendors = [vendor for vendor in vendors if vendor.id in keep_vendor_list]
 
+    # Looked up with `bsearch`
+    vendors.sort(key=lambda vendor: vendor.id)
+    for vendor in vendors:
+        vendor.devices.sort(key=lambda device: device.id)
+
     for vendor in vendors:
         if vendor.devices:
             piece = ',\n    '.join('{{ 0x{:04X}, "{}" }}'.format(device.id, device.name.replace('"', '\\"')) for device in vendor.devices)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/attributes.h"
+#include "common/mallocHelper.h"
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -31,7 +32,11 @@ static inline void ffListInit(FFlist* list) {
 static inline void ffListInitA(FFlist* list, uint32_t elementSize, uint32_t capacity) {
     ffListInit(list);
     list->capacity = capacity;
-    list->data = __builtin_expect(capacity == 0, 0) ? NULL : (uint8_t*) malloc((size_t) capacity * elementSize);
+    if (__builtin_expect(capacity == 0, 0)) {
+        return;
+    }
+    ffAllocCountAdd();
+    list->data = (uint8_t*) malloc((size_t) capacity * elementSize);
 }
 
 FF_A_NODISCARD static inline FFlist ffListCreate() {
@@ -101,6 +106,7 @@ static inline void ffListReserve(FFlist* list, uint32_t elementSize, uint32_t ne
         return;
     }
 
+    ffAllocCountAdd();
     list->data = (uint8_t*) realloc(list->data, (size_t) newCapacity * elementSize);
     list->capacity = newCapacity;
 }
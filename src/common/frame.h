@@ -0,0 +1,17 @@
+#pragma once
+
+#include "fastfetch.h"
+
+// Composes a whole screen (logo, keys and values) before it's written to the terminal.
+// stdout is fully buffered, so `ffFrameEnd` normally emits the frame with a single `write`,
+// and pipes and slow ptys never show a half drawn screen. fd 1 always stays the real terminal.
+// In `--dynamic-interval` mode, stdio output between `ffFrameBegin` and `ffFrameEnd` is collected in memory,
+// so that frames after the first only redraw the lines that changed since the previous frame.
+// Direct writes to fd 1 (e.g. image logos) must happen outside of a frame.
+// No-op on Windows and with `--no-buffer`. Not thread-safe; must be used in main thread only
+
+void ffFrameBegin(void);
+void ffFrameEnd(void);
+
+// While suspended, stdio output goes to the terminal directly; used by `ffSuppressIO`
+void ffFrameSuspend(bool suspend);
@@ -7,11 +7,13 @@
 #include <math.h>
 
 char* CHAR_NULL_PTR = "";
+uint32_t ffAllocCount;
 
 void ffStrbufInitA(FFstrbuf* strbuf, uint32_t allocate) {
     strbuf->allocated = allocate;
 
     if (strbuf->allocated > 0) {
+        ffAllocCountAdd();
         strbuf->chars = (char*) malloc(sizeof(char) * strbuf->allocated);
     }
 
@@ -23,6 +25,7 @@ void ffStrbufInitVF(FFstrbuf* strbuf, const char* format, va_list arguments) {
     assert(format != NULL);
 
     char* buffer = NULL;
+    ffAllocCountAdd();
     int len = vasprintf(&buffer, format, arguments);
     assert(len >= 0);
 
@@ -60,6 +63,7 @@ void ffStrbufEnsureFree(FFstrbuf* strbuf, uint32_t free) {
     }
 
     if (strbuf->allocated == 0) {
+        ffAllocCountAdd();
         char* newbuf = malloc(sizeof(*strbuf->chars) * allocate);
         if (strbuf->length == 0) {
             *newbuf = '\0';
@@ -68,6 +72,7 @@ void ffStrbufEnsureFree(FFstrbuf* strbuf, uint32_t free) {
         }
         strbuf->chars = newbuf;
     } else {
+        ffAllocCountAdd();
         strbuf->chars = realloc(strbuf->chars, sizeof(*strbuf->chars) * allocate);
     }
 
@@ -86,6 +91,7 @@ void ffStrbufEnsureFixedLengthFree(FFstrbuf* strbuf, uint32_t free) {
 
     if (strbuf->allocated == 0) {
         newCap += strbuf->length + 1;
+        ffAllocCountAdd();
         char* newbuf = malloc(sizeof(*strbuf->chars) * newCap);
         if (strbuf->length == 0) {
             *newbuf = '\0';
@@ -94,6 +100,7 @@ void ffStrbufEnsureFixedLengthFree(FFstrbuf* strbuf, uint32_t free) {
         }
         strbuf->chars = newbuf;
     } else {
+        ffAllocCountAdd();
         strbuf->chars = realloc(strbuf->chars, sizeof(*strbuf->chars) * newCap);
     }
 
@@ -248,6 +255,7 @@ void ffStrbufSetNS(FFstrbuf* strbuf, uint32_t length, const char* value) {
     assert(value != NULL);
 
     if (strbuf->allocated <= length) {
+        ffAllocCountAdd();
         char* newBuf = malloc(sizeof(char) * (length + 1));
         memcpy(newBuf, value, length);
         if (strbuf->allocated > 0) {
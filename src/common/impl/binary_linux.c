@@ -1,13 +1,47 @@
 #include "common/binary.h"
+#include "common/io.h"
+#include "common/strutil.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __sun
+    #include <sys/elf.h>
+#else
+    #include <elf.h>
+#endif
+
+/**
+ * Scans a section for NUL-terminated string literals
+ *
+ * Strings starting with a printable ASCII character and at least `minLength` long
+ * are passed to the callback. Stops as soon as the callback returns false.
+ * The NUL terminators are located with memchr, which libc vectorizes
+ */
+static void scanStrings(const char* data, size_t size, bool (*cb)(const char* str, uint32_t len, void* userdata), void* userdata, uint32_t minLength) {
+    const char* end = data + size;
+    for (const char* p = data; p < end;) {
+        const char* nul = memchr(p, '\0', (size_t) (end - p));
+        size_t len = (size_t) ((nul ? nul : end) - p);
+        if (len >= minLength && *p >= ' ' && *p <= '~') { // Ignore control characters
+            if (!cb(p, (uint32_t) len, userdata)) {
+                return;
+            }
+        }
+        if (!nul) {
+            break;
+        }
+        p = nul + 1;
+    }
+}
 
 #if defined(FF_HAVE_ELF) || defined(__sun) || (defined(__FreeBSD__) && !defined(__DragonFly__)) || defined(__OpenBSD__) || defined(__NetBSD__)
+    #define FF_BINARY_HAVE_LIBELF 1
 
-    #include "common/io.h"
     #include "common/library.h"
-    #include "common/strutil.h"
 
     #include <libelf.h> // #1254
-    #include <fcntl.h>
 
 /**
  * Structure to hold dynamically loaded libelf function pointers
@@ -27,16 +61,12 @@ struct FFElfData {
 } elfData;
 
 /**
- * Extracts string literals from an ELF (Linux/Unix) binary file
+ * Extracts string literals from an ELF binary file using libelf
  *
- * This function loads the libelf library dynamically, opens the ELF file,
- * locates the .rodata section (which contains string literals), and
- * scans it for valid strings. Each string found is passed to the
- * callback function for processing.
- *
- * The function supports both 32-bit and 64-bit ELF formats.
+ * Fallback of the built-in parser for ELF layouts it doesn't understand.
+ * Loads the libelf library dynamically, locates the .rodata section and scans it.
  */
-const char* ffBinaryExtractStrings(const char* elfFile, bool (*cb)(const char* str, uint32_t len, void* userdata), void* userdata, uint32_t minLength) {
+static const char* extractStringsLibelf(const char* elfFile, bool (*cb)(const char* str, uint32_t len, void* userdata), void* userdata, uint32_t minLength) {
     // Initialize libelf if not already done
     if (!elfData.inited) {
         elfData.inited = true;
@@ -107,26 +137,7 @@ const char* ffBinaryExtractStrings(const char* elfFile, bool (*cb)(const char* s
         }
 
         // Scan the section for string literals
-        for (size_t off = 0; off < data->d_size; ++off) {
-            const char* p = (const char*) data->d_buf + off;
-            if (*p == '\0') {
-                continue;
-            }
-            uint32_t len = (uint32_t) strnlen(p, data->d_size - off);
-            if (len < minLength) {
-                off += len;
-                continue;
-            }
-            // Only process printable ASCII characters
-            if (*p >= ' ' && *p <= '~') // Ignore control characters
-            {
-                if (!cb(p, len, userdata)) {
-                    break;
-                }
-            }
-            off += len;
-        }
-
+        scanStrings(data->d_buf, data->d_size, cb, userdata, minLength);
         break;
     }
 
@@ -134,14 +145,153 @@ const char* ffBinaryExtractStrings(const char* elfFile, bool (*cb)(const char* s
     return NULL;
 }
 
-#else
+#endif
+
+typedef struct FFElfFile {
+    const uint8_t* data;
+    size_t length;
+    bool is64;
+    bool bigEndian;
+} FFElfFile;
+
+// Returned for ELF files the built-in parser can't handle, which are retried with libelf
+static const char* const unsupportedElfError = "Unsupported ELF layout";
 
 /**
- * Fallback implementation when libelf is not available
+ * Reads an unsigned integer of `size` bytes at `offset`, in the byte order of the ELF file
+ *
+ * @return false if the value is out of the file
  */
-const char* ffBinaryExtractStrings(const char* file, bool (*cb)(const char* str, uint32_t len, void* userdata), void* userdata, uint32_t minLength) {
-    FF_UNUSED(file, cb, userdata, minLength);
-    return "Fastfetch was built without libelf support";
+static bool readUInt(const FFElfFile* elf, uint64_t offset, uint32_t size, uint64_t* value) {
+    if (offset > elf->length || size > elf->length - offset) {
+        return false;
+    }
+
+    const uint8_t* p = elf->data + offset;
+    *value = 0;
+    for (uint32_t i = 0; i < size; ++i) {
+        *value |= (uint64_t) p[elf->bigEndian ? i : size - 1 - i] << ((size - 1 - i) * 8);
+    }
+    return true;
+}
+
+// Reads `field` of the `Elf32_type` / `Elf64_type` struct located at `base`, according to the ELF class
+#define FF_ELF_READ(elf, base, type, field, value)                                                       \
+    readUInt((elf), (base) + ((elf)->is64 ? offsetof(Elf64_##type, field) : offsetof(Elf32_##type, field)), \
+        (elf)->is64 ? (uint32_t) sizeof(((Elf64_##type*) NULL)->field) : (uint32_t) sizeof(((Elf32_##type*) NULL)->field), (value))
+
+/**
+ * Locates the .rodata section by walking the section headers of the mapped ELF file
+ *
+ * Supports ELF32 / ELF64 in both byte orders, and extended section numbering
+ */
+static const char* extractStringsElf(const FFElfFile* elf, bool (*cb)(const char* str, uint32_t len, void* userdata), void* userdata, uint32_t minLength) {
+    uint64_t shoff, shentsize, shnum, shstrndx;
+    if (!FF_ELF_READ(elf, 0, Ehdr, e_shoff, &shoff) ||
+        !FF_ELF_READ(elf, 0, Ehdr, e_shentsize, &shentsize) ||
+        !FF_ELF_READ(elf, 0, Ehdr, e_shnum, &shnum) ||
+        !FF_ELF_READ(elf, 0, Ehdr, e_shstrndx, &shstrndx)) {
+        return unsupportedElfError;
+    }
+
+    if (shoff == 0) {
+        return "No section headers found";
+    }
+    if (shentsize < (elf->is64 ? sizeof(Elf64_Shdr) : sizeof(Elf32_Shdr))) {
+        return unsupportedElfError;
+    }
+
+    // Extended section numbering: the real values are stored in the first section header
+    if (shnum == 0 && !FF_ELF_READ(elf, shoff, Shdr, sh_size, &shnum)) {
+        return unsupportedElfError;
+    }
+    if (shstrndx == SHN_XINDEX && !FF_ELF_READ(elf, shoff, Shdr, sh_link, &shstrndx)) {
+        return unsupportedElfError;
+    }
+    if (shstrndx >= shnum || shnum > (elf->length - shoff) / shentsize) {
+        return unsupportedElfError;
+    }
+
+    uint64_t namesOffset, namesSize;
+    if (!FF_ELF_READ(elf, shoff + shstrndx * shentsize, Shdr, sh_offset, &namesOffset) ||
+        !FF_ELF_READ(elf, shoff + shstrndx * shentsize, Shdr, sh_size, &namesSize) ||
+        namesOffset > elf->length || namesSize > elf->length - namesOffset) {
+        return unsupportedElfError;
+    }
+
+    for (uint64_t i = 0; i < shnum; ++i) {
+        uint64_t base = shoff + i * shentsize;
+        uint64_t name, type;
+        if (!FF_ELF_READ(elf, base, Shdr, sh_name, &name) || !FF_ELF_READ(elf, base, Shdr, sh_type, &type)) {
+            return unsupportedElfError;
+        }
+
+        if (type == SHT_NOBITS || name >= namesSize || namesSize - name < sizeof(".rodata") ||
+            memcmp(elf->data + namesOffset + name, ".rodata", sizeof(".rodata")) != 0) {
+            continue;
+        }
+
+        uint64_t offset, size;
+        if (!FF_ELF_READ(elf, base, Shdr, sh_offset, &offset) ||
+            !FF_ELF_READ(elf, base, Shdr, sh_size, &size) ||
+            offset > elf->length || size > elf->length - offset) {
+            return unsupportedElfError;
+        }
+
+        scanStrings((const char*) elf->data + offset, (size_t) size, cb, userdata, minLength);
+        break;
+    }
+
+    return NULL;
 }
 
+/**
+ * Extracts string literals from an ELF (Linux/Unix) binary file
+ *
+ * Maps the file into memory, locates the .rodata section (which contains string literals),
+ * and scans it for valid strings. Each string found is passed to the callback function.
+ * ELF layouts the built-in parser can't handle fall back to libelf, if available.
+ */
+const char* ffBinaryExtractStrings(const char* elfFile, bool (*cb)(const char* str, uint32_t len, void* userdata), void* userdata, uint32_t minLength) {
+    FF_AUTO_CLOSE_FD int fd = open(elfFile, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return "open() failed";
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        return "fstat() failed";
+    }
+    if (st.st_size < EI_NIDENT) {
+        return "Not an ELF file";
+    }
+
+    FFElfFile elf = {
+        .length = (size_t) st.st_size,
+    };
+    elf.data = mmap(NULL, elf.length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (elf.data == MAP_FAILED) {
+        return "mmap() failed";
+    }
+
+    const char* error;
+    if (memcmp(elf.data, ELFMAG, SELFMAG) != 0) {
+        error = "Not an ELF file";
+    } else if ((elf.data[EI_CLASS] != ELFCLASS32 && elf.data[EI_CLASS] != ELFCLASS64) ||
+        (elf.data[EI_DATA] != ELFDATA2LSB && elf.data[EI_DATA] != ELFDATA2MSB)) {
+        error = unsupportedElfError;
+    } else {
+        elf.is64 = elf.data[EI_CLASS] == ELFCLASS64;
+        elf.bigEndian = elf.data[EI_DATA] == ELFDATA2MSB;
+        error = extractStringsElf(&elf, cb, userdata, minLength);
+    }
+    munmap((void*) elf.data, elf.length);
+
+#ifdef FF_BINARY_HAVE_LIBELF
+    if (error == unsupportedElfError) {
+        error = extractStringsLibelf(elfFile, cb, userdata, minLength);
+    }
 #endif
+
+    return error;
+}
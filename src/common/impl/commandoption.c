@@ -2,7 +2,9 @@
 #include "common/color.h"
 #include "common/printing.h"
 #include "common/time.h"
+#include "common/trace.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
 #include "common/strutil.h"
 #include "fastfetch_datatext.h"
 #include "modules/modules.h"
@@ -89,6 +91,14 @@ void ffPrepareCommandOption(FFdata* data) {
                 break;
             #endif
 
+            #if !FF_MODULE_DISABLE_EDITOR
+            case 'E':
+            case 'e':
+                FF_IF_MODULE_MATCH(FF_EDITOR_MODULE_NAME)
+                ffPrepareEditor();
+                break;
+            #endif
+
             #if !FF_MODULE_DISABLE_NETIO
             case 'N':
             case 'n':
@@ -100,14 +110,23 @@ void ffPrepareCommandOption(FFdata* data) {
                 break;
             #endif
 
-            #if !FF_MODULE_DISABLE_PUBLICIP
+            #if !FF_MODULE_DISABLE_PACKAGES || !FF_MODULE_DISABLE_PUBLICIP
             case 'P':
             case 'p':
+                #if !FF_MODULE_DISABLE_PACKAGES
+                FF_IF_MODULE_MATCH(FF_PACKAGES_MODULE_NAME) {
+                    FF_A_CLEANUP(ffDestroyPackagesOptions) FFPackagesOptions options;
+                    ffInitPackagesOptions(&options);
+                    ffPreparePackages(&options);
+                }
+                #endif
+                #if !FF_MODULE_DISABLE_PUBLICIP
                 FF_IF_MODULE_MATCH(FF_PUBLICIP_MODULE_NAME) {
                     FF_A_CLEANUP(ffDestroyPublicIpOptions) FFPublicIPOptions options;
                     ffInitPublicIpOptions(&options);
                     ffPreparePublicIp(&options);
                 }
+                #endif
                 break;
             #endif
 
@@ -160,7 +179,11 @@ static void genJsonResult(FFdata* data, FFModuleBaseInfo* baseInfo, void* option
     yyjson_mut_doc* doc = data->resultDoc;
     yyjson_mut_val* module = yyjson_mut_arr_add_obj(doc, doc->root);
     yyjson_mut_obj_add_str(doc, module, "type", baseInfo->name);
-    if (baseInfo->generateJsonResult) {
+    if (baseInfo->detectResult) {
+        void* result;
+        const char* error = ffModuleResultDetect(baseInfo, options, "", &result);
+        baseInfo->generateJsonResultFrom(options, error, result, doc, module);
+    } else if (baseInfo->generateJsonResult) {
         baseInfo->generateJsonResult(options, doc, module);
     } else {
         yyjson_mut_obj_add_str(doc, module, "error", "Unsupported for JSON format");
@@ -179,6 +202,11 @@ static bool parseStructureCommand(
                 baseInfo->initOptions(optionBuf);
                 if (data->resultDoc != NULL) {
                     fn(data, baseInfo, optionBuf);
+                } else if (baseInfo->detectResult) {
+                    // Module options can't be customized in command line mode, so all instances share the same result
+                    void* result;
+                    const char* error = ffModuleResultDetect(baseInfo, optionBuf, "", &result);
+                    baseInfo->printResult(optionBuf, error, result);
                 } else {
                     baseInfo->printModule(optionBuf);
                 }
@@ -211,24 +239,31 @@ void ffPrintCommandOption(FFdata* data) {
         }
 
         double ms = 0;
+        uint32_t allocs = 0;
         if (thres >= 0) {
             ms = ffTimeGetTick();
+            allocs = ffAllocCountGet();
         }
 
-        parseStructureCommand(data, moduleType, genJsonResult);
+        {
+            FF_TRACE_SPAN(span, "module", moduleType);
+            parseStructureCommand(data, moduleType, genJsonResult);
+        }
 
         if (thres >= 0) {
             ms = ffTimeGetTick() - ms;
+            allocs = ffAllocCountGet() - allocs;
 
             if (data->resultDoc) {
                 yyjson_mut_val* moduleJson = yyjson_mut_arr_get_last(data->resultDoc->root);
                 yyjson_mut_obj_add_real(data->resultDoc, moduleJson, "stat", ms);
+                yyjson_mut_obj_add_uint(data->resultDoc, moduleJson, "allocs", allocs);
             } else {
                 char str[64];
-                int len = snprintf(str, sizeof str, "%.3fms", ms);
+                int len = snprintf(str, sizeof str, "%u allocs, %.3fms", allocs, ms);
                 if (thres > 0) {
-                    snprintf(str, sizeof str, "\e[%sm%.3fms\e[m", (ms <= thres ? FF_COLOR_FG_GREEN : ms <= 2 * thres ? FF_COLOR_FG_YELLOW
-                                                                                                                     : FF_COLOR_FG_RED),
+                    snprintf(str, sizeof str, "%u allocs, \e[%sm%.3fms\e[m", allocs, (ms <= thres ? FF_COLOR_FG_GREEN : ms <= 2 * thres ? FF_COLOR_FG_YELLOW
+                                                                                                                               : FF_COLOR_FG_RED),
                         ms);
                 }
                 printf("\e7\e[1A\e[9999999C\e[%dD%s\e8", len - 1, str); // Save; Up 1; Right 9999999; Left <len - 1>; Print <str>; Load
@@ -241,6 +276,8 @@ void ffPrintCommandOption(FFdata* data) {
         }
 #endif
     }
+
+    ffModuleResultClear();
 }
 
 void ffMigrateCommandOptionToJsonc(FFdata* data) {
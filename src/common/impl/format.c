@@ -127,6 +127,89 @@ FF_A_UNUSED static inline void normalizeArgName(FFstrbuf* dst, const char* src)
     }
 }
 
+static inline uint64_t hashFormatString(uint32_t length, const char* chars) {
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a
+    for (uint32_t i = 0; i < length; ++i) {
+        hash = (hash ^ (uint8_t) chars[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+#if FF_HAVE_LUA || FF_HAVE_QUICKJS
+typedef struct FFScriptArgName {
+    const char* source; // `FFformatarg::name`
+    FFstrbuf name;      // Property name exposed to scripts
+} FFScriptArgName;
+
+// Scripted format strings are rendered once per module instance and tick. Keep what can be reused across calls
+typedef struct FFScriptCacheEntry {
+    uint64_t hash;      // FNV-1a of `script`
+    FFstrbuf script;    // Copy of the script; the same script may be stored in different strings
+    uint32_t lastUsed;  // Value of `scriptCacheTick` at the last lookup
+    int ref;            // Lua: registry reference of the compiled chunk; 0 if none
+    FFlist argNames;    // List of FFScriptArgName, indexed like the arguments
+} FFScriptCacheEntry;
+
+enum { FF_FORMAT_MAX_SCRIPTS = 32 };
+
+static uint32_t scriptCacheTick;
+
+static FFScriptCacheEntry* findScript(FFlist* cache, uint64_t hash, const char* script, uint32_t scriptLen) {
+    FF_LIST_FOR_EACH (FFScriptCacheEntry, entry, *cache) {
+        if (entry->hash == hash && entry->script.length == scriptLen && memcmp(entry->script.chars, script, scriptLen) == 0) {
+            entry->lastUsed = ++scriptCacheTick;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// When the cache is full, the least recently used entry is reused. Its `ref` is kept for the caller to release
+static FFScriptCacheEntry* addScript(FFlist* cache, uint64_t hash, const char* script, uint32_t scriptLen) {
+    FFScriptCacheEntry* entry;
+    if (cache->length < FF_FORMAT_MAX_SCRIPTS) {
+        entry = FF_LIST_ADD(FFScriptCacheEntry, *cache);
+        ffStrbufInit(&entry->script);
+        entry->ref = 0;
+        ffListInit(&entry->argNames);
+    } else {
+        entry = FF_LIST_GET(FFScriptCacheEntry, *cache, 0);
+        FF_LIST_FOR_EACH (FFScriptCacheEntry, candidate, *cache) {
+            if (candidate->lastUsed < entry->lastUsed) {
+                entry = candidate;
+            }
+        }
+        FF_LIST_FOR_EACH (FFScriptArgName, argName, entry->argNames) {
+            ffStrbufDestroy(&argName->name);
+        }
+        ffListClear(&entry->argNames);
+    }
+    entry->hash = hash;
+    ffStrbufSetNS(&entry->script, scriptLen, script);
+    entry->lastUsed = ++scriptCacheTick;
+    return entry;
+}
+
+static const char* getScriptArgName(FFScriptCacheEntry* entry, uint32_t index, const FFformatarg* arg) {
+    while (entry->argNames.length <= index) {
+        FFScriptArgName* argName = FF_LIST_ADD(FFScriptArgName, entry->argNames);
+        argName->source = NULL;
+        ffStrbufInit(&argName->name);
+    }
+
+    FFScriptArgName* argName = FF_LIST_GET(FFScriptArgName, entry->argNames, index);
+    if (argName->name.length == 0 || argName->source != arg->name) {
+        argName->source = arg->name;
+        if (arg->name && arg->name[0]) {
+            normalizeArgName(&argName->name, arg->name);
+        } else {
+            ffStrbufSetF(&argName->name, "arg%" PRIu32, index + 1);
+        }
+    }
+    return argName->name.chars;
+}
+#endif
+
 #if FF_HAVE_LUA
     #include "common/lua.h"
 
@@ -151,17 +234,28 @@ static bool parseLuaString(FFstrbuf* buffer, const char* script, uint32_t script
         return false;
     }
 
-    FF_STRBUF_AUTO_DESTROY argNameBuf = ffStrbufCreate();
     bool ret = false;
 
     lua_State* L = luaData.L;
-    // Clear stack and load chunk
+    // Clear stack and load chunk. Compiled chunks are kept in the registry
     lua_settop(L, 0);
-    if (luaL_loadbuffer(L, script, scriptLen, "") != LUA_OK) {
+    uint64_t hash = hashFormatString(scriptLen, script);
+    FFScriptCacheEntry* entry = findScript(&luaData.formatScripts, hash, script, scriptLen);
+    if (!entry && luaL_loadbuffer(L, script, scriptLen, "") == LUA_OK) {
+        entry = addScript(&luaData.formatScripts, hash, script, scriptLen);
+        if (entry->ref > 0) {
+            luaL_unref(L, LUA_REGISTRYINDEX, entry->ref); // Chunk of the evicted script
+        }
+        entry->ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+
+    if (!entry) {
         appendLuaError(buffer, "Lua load error", L);
     } else {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, entry->ref);
+
         // Build args table for name lookup only.
-        lua_createtable(L, 0, 0);
+        lua_createtable(L, 0, (int) numArgs);
 
         for (uint32_t i = 0; i < numArgs; ++i) {
             const FFformatarg* arg = &arguments[i];
@@ -212,12 +306,7 @@ static bool parseLuaString(FFstrbuf* buffer, const char* script, uint32_t script
                     lua_pushnil(L);
                     break;
             }
-            if (arg->name && arg->name[0]) {
-                normalizeArgName(&argNameBuf, arg->name);
-            } else {
-                ffStrbufSetF(&argNameBuf, "arg%" PRIu32, i + 1);
-            }
-            lua_setfield(L, -2, argNameBuf.chars);
+            lua_setfield(L, -2, getScriptArgName(entry, i, arg));
         }
 
         if (lua_pcall(L, 1, LUA_MULTRET, 0) != LUA_OK) {
@@ -269,6 +358,7 @@ struct FFQuickJSData {
     JSRuntime* rt;
     JSContext* ctx;
     bool inited;
+    FFlist formatScripts; // List of FFScriptCacheEntry
 } qjsData;
 
 static const char* loadQuickJSState(void) {
@@ -312,8 +402,6 @@ static const char* loadQuickJSState(void) {
         return "JS_NewContext() failed";
     }
 
-    libqjs = NULL; // don't close quickjs
-
     return NULL;
 }
 
@@ -325,7 +413,13 @@ static bool parseQuickJSString(FFstrbuf* buffer, const char* script, uint32_t sc
     }
     JSContext* ctx = qjsData.ctx;
     JSValue argsObj = qjsData.ffJS_NewObject(ctx);
-    FF_STRBUF_AUTO_DESTROY argNameBuf = ffStrbufCreate();
+
+    // The script itself is still evaluated every time: the public API can only run precompiled global code with `globalThis` bound to `this`
+    uint64_t hash = hashFormatString(scriptLen, script);
+    FFScriptCacheEntry* entry = findScript(&qjsData.formatScripts, hash, script, scriptLen);
+    if (!entry) {
+        entry = addScript(&qjsData.formatScripts, hash, script, scriptLen);
+    }
 
     for (uint32_t i = 0; i < numArgs; ++i) {
         const FFformatarg* arg = &arguments[i];
@@ -387,12 +481,7 @@ static bool parseQuickJSString(FFstrbuf* buffer, const char* script, uint32_t sc
                 break;
         }
 
-        if (arg->name && arg->name[0]) {
-            normalizeArgName(&argNameBuf, arg->name);
-        } else {
-            ffStrbufSetF(&argNameBuf, "arg%" PRIu32, i + 1);
-        }
-        qjsData.ffJS_SetPropertyStr(ctx, argsObj, argNameBuf.chars, value);
+        qjsData.ffJS_SetPropertyStr(ctx, argsObj, getScriptArgName(entry, i, arg), value);
     }
     JSValue result = qjsData.ffJS_EvalThis(ctx, argsObj, script, scriptLen, "", JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_STRICT);
 
@@ -451,287 +540,475 @@ static bool skipAnsiEscape(FFstrbuf* in, FFstrbuf* out, FFstrbuf* trailingEscape
     return false;
 }
 
-static bool parseFormatString(FFstrbuf* buffer, const FFstrbuf* formatstr, uint32_t numArgs, const FFformatarg* arguments) {
-    uint32_t argCounter = 0;
+// Format strings are compiled into a list of ops on first use and cached by content,
+// so that each print only walks the ops instead of re-tokenizing the format string
+
+typedef enum FF_A_PACKED FFFormatOpType {
+    FF_FORMAT_OP_LITERAL,    // Append `text`
+    FF_FORMAT_OP_COLOR,      // Append `text` unless `--pipe`
+    FF_FORMAT_OP_STOP,       // `{-}`
+    FF_FORMAT_OP_IF,         // `{?arg}`: jump to `jump` if `arg` is not set
+    FF_FORMAT_OP_IF_NOT,     // `{/arg}`: jump to `jump` if `arg` is set
+    FF_FORMAT_OP_END_IF,     // `{?}`
+    FF_FORMAT_OP_END_IF_NOT, // `{/}`
+    FF_FORMAT_OP_CONSTANT,   // `{$1}`
+    FF_FORMAT_OP_ENV,        // `{$NAME}`, `text` is the NUL-terminated variable name
+    FF_FORMAT_OP_ARG,        // `{arg}`, `{arg:10}`, `{arg~1,5}`, ...
+} FFFormatOpType;
+
+typedef enum FF_A_PACKED FFFormatSliceType {
+    FF_FORMAT_SLICE_SUFFIX,  // `~start`
+    FF_FORMAT_SLICE_RANGE,   // `~start,end`
+    FF_FORMAT_SLICE_BAD_END, // `~start,???`
+    FF_FORMAT_SLICE_BAD,     // `~start???`
+} FFFormatSliceType;
+
+typedef struct FFFormatSpan {
+    uint32_t offset; // into `FFFormatProgram::pool`
+    uint32_t length;
+} FFFormatSpan;
+
+typedef struct FFFormatArgRef {
+    uint32_t index;       // 1-based; 0 uses the arg counter. For named args, the 0-based index where `argName` was found last time
+    uint32_t nameOffset;  // into `FFFormatProgram::pool`; UINT32_MAX if referenced by index
+    const char* argName;  // `FFformatarg::name` found at `index` last time
+} FFFormatArgRef;
+
+typedef struct FFFormatOp {
+    FFFormatOpType type;
+    char sep;              // FF_FORMAT_OP_ARG: '\0', ':', '<', '>', '|', '~'; 'x' if the part after the separator is invalid
+    FFFormatSliceType slice;
+    FFFormatSpan text;
+    FFFormatSpan invalid;  // The placeholder as written, appended when it can't be evaluated
+    FFFormatArgRef arg;
+    int32_t num1;          // Truncation length, slice start or constant index
+    int32_t num2;          // Slice end
+    uint32_t jump;         // Index of the op to continue with
+} FFFormatOp;
+
+typedef struct FFFormatJump {
+    uint32_t op;     // Index of the `{?arg}` / `{/arg}` op
+    uint32_t target; // Source position behind the matching `{?}` / `{/}`
+} FFFormatJump;
+
+typedef struct FFFormatProgram {
+    uint64_t hash;
+    FFstrbuf source;
+    FFstrbuf pool;
+    FFlist ops; // List of FFFormatOp
+} FFFormatProgram;
+
+enum { FF_FORMAT_MAX_PROGRAMS = 128 };
+
+static FFlist programs; // List of FFFormatProgram
+
+static FFFormatSpan addToPool(FFFormatProgram* program, uint32_t length, const char* chars) {
+    FFFormatSpan span = { program->pool.length, length };
+    ffStrbufAppendNS(&program->pool, length, chars);
+    ffStrbufAppendC(&program->pool, '\0');
+    return span;
+}
 
-    uint32_t numOpenIfs = 0;
-    uint32_t numOpenNotIfs = 0;
+static FFFormatOp* addOp(FFFormatProgram* program, FFFormatOpType type, FFFormatSpan invalid) {
+    FFFormatOp* op = FF_LIST_ADD(FFFormatOp, program->ops);
+    *op = (FFFormatOp) { .type = type, .invalid = invalid, .arg.nameOffset = UINT32_MAX, .jump = UINT32_MAX };
+    return op;
+}
+
+static void addLiteral(FFFormatProgram* program, bool* literalOpen, uint32_t length, const char* chars) {
+    if (*literalOpen) {
+        // The pool ends with the NUL of the open literal; extend it in place
+        FFFormatOp* op = FF_LIST_GET(FFFormatOp, program->ops, program->ops.length - 1);
+        ffStrbufSubstrBefore(&program->pool, program->pool.length - 1);
+        ffStrbufAppendNS(&program->pool, length, chars);
+        ffStrbufAppendC(&program->pool, '\0');
+        op->text.length += length;
+        return;
+    }
+    addOp(program, FF_FORMAT_OP_LITERAL, (FFFormatSpan) {})->text = addToPool(program, length, chars);
+    *literalOpen = true;
+}
+
+// Same rules as `getArgumentIndex`, except that names are resolved when the program runs
+static bool compileArgRef(FFFormatProgram* program, FFFormatArgRef* ref, const char* placeholderValue, uint32_t numArgs, const FFformatarg* arguments) {
+    char firstChar = placeholderValue[0];
+    if (firstChar == '\0') {
+        ref->index = 0;
+        return true;
+    }
+
+    if (firstChar >= '0' && firstChar <= '9') {
+        char* pEnd = NULL;
+        ref->index = (uint32_t) strtoul(placeholderValue, &pEnd, 10);
+        return *pEnd == '\0';
+    }
+
+    if (ffCharIsEnglishAlphabet(firstChar)) {
+        ref->nameOffset = addToPool(program, (uint32_t) strlen(placeholderValue), placeholderValue).offset;
+        ref->index = getArgumentIndex(placeholderValue, numArgs, arguments);
+        if (ref->index != UINT32_MAX) {
+            ref->argName = arguments[--ref->index].name;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+static void compileFormatString(FFFormatProgram* program, uint32_t numArgs, const FFformatarg* arguments) {
+    const FFstrbuf* formatstr = &program->source;
+    bool literalOpen = false;
+
+    // `{?arg}` and `{/arg}` jump behind the next `{?}` / `{/}` in the source, regardless of nesting
+    FF_LIST_AUTO_DESTROY pendingJumps = ffListCreate(); // List of FFFormatJump
 
     FF_STRBUF_AUTO_DESTROY placeholderValue = ffStrbufCreate();
 
     for (uint32_t i = 0; i < formatstr->length; ++i) {
-        // if we don't have a placeholder start just copy the chars over to output buffer
+        FF_LIST_FOR_EACH (FFFormatJump, jump, pendingJumps) {
+            if (jump->target == i) {
+                FF_LIST_GET(FFFormatOp, program->ops, jump->op)->jump = program->ops.length;
+                literalOpen = false;
+            }
+        }
+
         if (formatstr->chars[i] != '{') {
-            ffStrbufAppendC(buffer, formatstr->chars[i]);
+            addLiteral(program, &literalOpen, 1, &formatstr->chars[i]);
             continue;
         }
 
-        // jump to next char, the start of the placeholder value
-        ++i;
+        uint32_t start = i++;
 
         // unmatched trailing '{'
         if (i >= formatstr->length) {
-            ffStrbufAppendC(buffer, '{');
+            addLiteral(program, &literalOpen, 1, "{");
             break;
         }
 
         // double {{ elvaluates to a single { and doesn't count as start
         if (formatstr->chars[i] == '{') {
-            ffStrbufAppendC(buffer, '{');
+            addLiteral(program, &literalOpen, 1, "{");
             continue;
         }
 
         ffStrbufClear(&placeholderValue);
-
         {
             uint32_t iEnd = ffStrbufNextIndexC(formatstr, i, '}');
             ffStrbufAppendNS(&placeholderValue, iEnd - i, &formatstr->chars[i]);
             i = iEnd;
         }
 
+        uint32_t invalidLength = (i < formatstr->length ? i + 1 : i) - start;
+        FFFormatSpan invalid = addToPool(program, invalidLength, &formatstr->chars[start]);
+        literalOpen = false;
+
         char firstChar = placeholderValue.chars[0];
 
         if (placeholderValue.length == 1) {
-            // test if for stop, if so break the loop
             if (firstChar == '-') {
-                break;
+                addOp(program, FF_FORMAT_OP_STOP, invalid);
+                continue;
             }
-
-            // test for end of an if, if so do nothing
             if (firstChar == '?') {
-                if (numOpenIfs == 0) {
-                    appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-                } else {
-                    --numOpenIfs;
-                }
-
+                addOp(program, FF_FORMAT_OP_END_IF, invalid);
                 continue;
             }
-
-            // test for end of a not if, if so do nothing
             if (firstChar == '/') {
-                if (numOpenNotIfs == 0) {
-                    appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-                } else {
-                    --numOpenNotIfs;
-                }
-
+                addOp(program, FF_FORMAT_OP_END_IF_NOT, invalid);
                 continue;
             }
-
-            // test for end of a color, if so do nothing
             if (firstChar == '#') {
-                if (!instance.config.display.pipe) {
-                    ffStrbufAppendS(buffer, FASTFETCH_TEXT_MODIFIER_RESET);
-                }
-
+                addOp(program, FF_FORMAT_OP_COLOR, invalid)->text = addToPool(program, (uint32_t) strlen(FASTFETCH_TEXT_MODIFIER_RESET), FASTFETCH_TEXT_MODIFIER_RESET);
                 continue;
             }
         }
 
-        // test for if, if so evaluate it
-        if (firstChar == '?') {
-            ffStrbufSubstrAfter(&placeholderValue, 0);
-
-            uint32_t index = getArgumentIndex(placeholderValue.chars, numArgs, arguments);
-
-            // testing for an invalid index
-            if (index > numArgs || index < 1) {
-                appendInvalidPlaceholder(buffer, "{?", &placeholderValue, i, formatstr->length);
+        if (firstChar == '?' || firstChar == '/') {
+            FFFormatOp* op = addOp(program, firstChar == '?' ? FF_FORMAT_OP_IF : FF_FORMAT_OP_IF_NOT, invalid);
+            if (!compileArgRef(program, &op->arg, placeholderValue.chars + 1, numArgs, arguments) || (op->arg.nameOffset == UINT32_MAX && op->arg.index == 0)) {
+                // Can never be evaluated
+                op->type = FF_FORMAT_OP_LITERAL;
+                op->text = invalid;
                 continue;
             }
 
-            // continue normally if an format arg is set and the value is > 0
-            if (formatArgSet(&arguments[index - 1])) {
-                ++numOpenIfs;
-                continue;
-            }
-
-            // fastforward to the end of the if without printing the in between
-            i = ffStrbufNextIndexS(formatstr, i, "{?}") + 2; // 2 is the length of "{?}" - 1 because the loop will increment it again directly after continue
+            *FF_LIST_ADD(FFFormatJump, pendingJumps) = (FFFormatJump) {
+                .op = program->ops.length - 1,
+                .target = ffStrbufNextIndexS(formatstr, i, firstChar == '?' ? "{?}" : "{/}") + 3,
+            };
             continue;
         }
 
-        // test for not if, if so evaluate it
-        if (firstChar == '/') {
-            ffStrbufSubstrAfter(&placeholderValue, 0);
-
-            uint32_t index = getArgumentIndex(placeholderValue.chars, numArgs, arguments);
-
-            // testing for an invalid index
-            if (index > numArgs || index < 1) {
-                appendInvalidPlaceholder(buffer, "{/", &placeholderValue, i, formatstr->length);
-                continue;
-            }
-
-            // continue normally if an format arg is not set or the value is 0
-            if (!formatArgSet(&arguments[index - 1])) {
-                ++numOpenNotIfs;
-                continue;
-            }
-
-            // fastforward to the end of the if without printing the in between
-            i = ffStrbufNextIndexS(formatstr, i, "{/}") + 2; // 2 is the length of "{/}" - 1 because the loop will increment it again directly after continue
-            continue;
-        }
-
-        // test for color, if so evaluate it
         if (firstChar == '#') {
-            if (!instance.config.display.pipe) {
-                ffStrbufAppendS(buffer, "\e[");
-                ffOptionParseColorNoClear(placeholderValue.chars + 1, buffer);
-                ffStrbufAppendC(buffer, 'm');
-            }
+            FFFormatOp* op = addOp(program, FF_FORMAT_OP_COLOR, invalid);
+            FF_STRBUF_AUTO_DESTROY color = ffStrbufCreateS("\e[");
+            ffOptionParseColorNoClear(placeholderValue.chars + 1, &color);
+            ffStrbufAppendC(&color, 'm');
+            op->text = addToPool(program, color.length, color.chars);
             continue;
         }
 
-        // test for constant or env var, if so evaluate it
         if (firstChar == '$') {
             char* pend = NULL;
             int32_t indexSigned = (int32_t) strtol(placeholderValue.chars + 1, &pend, 10);
             if (pend == placeholderValue.chars + 1) {
-                // treat placeholder as an environment variable
-                char* envValue = getenv(placeholderValue.chars + 1);
-                if (envValue) {
-                    ffStrbufAppendS(buffer, envValue);
-                } else {
-                    appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-                }
+                addOp(program, FF_FORMAT_OP_ENV, invalid)->text = addToPool(program, placeholderValue.length - 1, placeholderValue.chars + 1);
+            } else if (*pend != '\0') {
+                addOp(program, FF_FORMAT_OP_LITERAL, invalid)->text = invalid;
             } else {
-                // treat placeholder as a constant
-                uint32_t index = (uint32_t) (indexSigned < 0 ? (int32_t) instance.config.display.constants.length + indexSigned : indexSigned - 1);
-
-                if (*pend != '\0' || instance.config.display.constants.length <= index) {
-                    appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-                } else {
-                    FFstrbuf* item = FF_LIST_GET(FFstrbuf, instance.config.display.constants, index);
-                    ffStrbufAppend(buffer, item);
-                }
+                addOp(program, FF_FORMAT_OP_CONSTANT, invalid)->num1 = indexSigned;
             }
             continue;
         }
 
+        FFFormatOp* op = addOp(program, FF_FORMAT_OP_ARG, invalid);
+
         char* pSep = placeholderValue.chars;
-        char cSep = '\0';
         while (*pSep && *pSep != ':' && *pSep != '<' && *pSep != '>' && *pSep != '|' && *pSep != '~') {
             ++pSep;
         }
+        op->sep = *pSep;
         if (*pSep) {
-            cSep = *pSep;
             *pSep = '\0';
-        } else {
-            pSep = NULL;
         }
 
-        uint32_t index = getArgumentIndex(placeholderValue.chars, numArgs, arguments);
-
-        // test for invalid index
-        if (index == 0) {
-            index = ++argCounter;
+        if (!compileArgRef(program, &op->arg, placeholderValue.chars, numArgs, arguments)) {
+            op->arg.index = UINT32_MAX;
         }
 
-        if (index > numArgs) {
-            if (pSep) {
-                *pSep = cSep;
+        if (op->sep == '~') {
+            char* pEnd = NULL;
+            op->num1 = (int32_t) strtol(pSep + 1, &pEnd, 10);
+            if (*pEnd == '\0') {
+                op->slice = FF_FORMAT_SLICE_SUFFIX;
+            } else if (*pEnd == ',') {
+                op->num2 = (int32_t) strtol(pEnd + 1, &pEnd, 10);
+                op->slice = *pEnd == '\0' ? FF_FORMAT_SLICE_RANGE : FF_FORMAT_SLICE_BAD_END;
+            } else {
+                op->slice = FF_FORMAT_SLICE_BAD;
+            }
+        } else if (op->sep != '\0') {
+            char* pEnd = NULL;
+            op->num1 = (int32_t) strtol(pSep + 1, &pEnd, 10);
+            if (*pEnd != '\0') {
+                op->sep = 'x';
             }
-            appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-            continue;
         }
+    }
 
-        if (!cSep) {
-            ffFormatAppendFormatArg(buffer, &arguments[index - 1]);
-        } else if (cSep == '~') {
-            FF_STRBUF_AUTO_DESTROY tempString = ffStrbufCreate();
-            ffFormatAppendFormatArg(&tempString, &arguments[index - 1]);
-            FF_STRBUF_AUTO_DESTROY trailingEscape = ffStrbufCreate();
-            skipAnsiEscape(&tempString, buffer, &trailingEscape);
+    FF_LIST_FOR_EACH (FFFormatJump, jump, pendingJumps) {
+        FFFormatOp* op = FF_LIST_GET(FFFormatOp, program->ops, jump->op);
+        if (op->jump == UINT32_MAX) {
+            op->jump = program->ops.length;
+        }
+    }
+}
 
-            char* pEnd = NULL;
-            int32_t start = (int32_t) strtol(pSep + 1, &pEnd, 10);
-            if (start < 0) {
-                start = (int32_t) tempString.length + start;
+static uint32_t resolveArgRef(const FFFormatProgram* program, FFFormatArgRef* ref, uint32_t numArgs, const FFformatarg* arguments) {
+    if (ref->nameOffset == UINT32_MAX) {
+        return ref->index > numArgs ? UINT32_MAX : ref->index;
+    }
+
+    if (ref->index < numArgs && arguments[ref->index].name == ref->argName) {
+        return ref->index + 1;
+    }
+
+    uint32_t index = getArgumentIndex(program->pool.chars + ref->nameOffset, numArgs, arguments);
+    if (index != UINT32_MAX) {
+        ref->index = index - 1;
+        ref->argName = arguments[index - 1].name;
+    }
+    return index;
+}
+
+static inline void appendSpan(FFstrbuf* buffer, const FFFormatProgram* program, FFFormatSpan span) {
+    ffStrbufAppendNS(buffer, span.length, program->pool.chars + span.offset);
+}
+
+static void appendSlice(FFstrbuf* buffer, const FFFormatProgram* program, const FFFormatOp* op, const FFformatarg* arg) {
+    FF_STRBUF_AUTO_DESTROY tempString = ffStrbufCreate();
+    ffFormatAppendFormatArg(&tempString, arg);
+    FF_STRBUF_AUTO_DESTROY trailingEscape = ffStrbufCreate();
+    skipAnsiEscape(&tempString, buffer, &trailingEscape);
+
+    int32_t start = op->num1;
+    if (start < 0) {
+        start = (int32_t) tempString.length + start;
+    }
+    bool inRange = start >= 0 && (uint32_t) start < tempString.length;
+    if (inRange) {
+        if (op->slice == FF_FORMAT_SLICE_SUFFIX) {
+            ffStrbufAppendNS(buffer, tempString.length - (uint32_t) start, &tempString.chars[start]);
+        } else if (op->slice == FF_FORMAT_SLICE_RANGE) {
+            int32_t end = op->num2;
+            if (end < 0) {
+                end = (int32_t) tempString.length + end;
             }
-            if (start >= 0 && (uint32_t) start < tempString.length) {
-                if (*pEnd == '\0') {
-                    ffStrbufAppendNS(buffer, tempString.length - (uint32_t) start, &tempString.chars[start]);
-                } else if (*pEnd == ',') {
-                    int32_t end = (int32_t) strtol(pEnd + 1, &pEnd, 10);
-                    if (!*pEnd) {
-                        if (end < 0) {
-                            end = (int32_t) tempString.length + end;
-                        }
-                        if ((uint32_t) end > tempString.length) {
-                            end = (int32_t) tempString.length;
-                        }
-                        if (end > start) {
-                            ffStrbufAppendNS(buffer, (uint32_t) (end - start), &tempString.chars[start]);
-                        }
-                    }
-                }
+            if ((uint32_t) end > tempString.length) {
+                end = (int32_t) tempString.length;
             }
-
-            if (trailingEscape.length > 0) {
-                ffStrbufAppend(buffer, &trailingEscape);
+            if (end > start) {
+                ffStrbufAppendNS(buffer, (uint32_t) (end - start), &tempString.chars[start]);
             }
+        }
+    }
 
-            if (*pEnd) {
-                *pSep = cSep;
-                appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-                continue;
-            }
+    if (trailingEscape.length > 0) {
+        ffStrbufAppend(buffer, &trailingEscape);
+    }
+
+    // A range is only parsed when its start is in range
+    if (op->slice == FF_FORMAT_SLICE_BAD || op->slice == FF_FORMAT_SLICE_BAD_END || (op->slice == FF_FORMAT_SLICE_RANGE && !inRange)) {
+        appendSpan(buffer, program, op->invalid);
+    }
+}
+
+static void appendTruncated(FFstrbuf* buffer, const FFFormatOp* op, const FFformatarg* arg) {
+    char cSep = op->sep;
+    int32_t truncLength = op->num1;
+    bool ellipsis = false;
+    if (truncLength < 0) {
+        ellipsis = true;
+        truncLength = -truncLength;
+    }
+
+    FF_STRBUF_AUTO_DESTROY tempString = ffStrbufCreate();
+    ffFormatAppendFormatArg(&tempString, arg);
+    FF_STRBUF_AUTO_DESTROY trailingEscape = ffStrbufCreate();
+    skipAnsiEscape(&tempString, buffer, &trailingEscape);
+
+    if (tempString.length == (uint32_t) truncLength) {
+        ffStrbufAppend(buffer, &tempString);
+    } else if (tempString.length > (uint32_t) truncLength) {
+        if (cSep == ':') {
+            ffStrbufSubstrBefore(&tempString, (uint32_t) truncLength);
+            ffStrbufTrimRightSpace(&tempString);
         } else {
-            char* pEnd = NULL;
-            int32_t truncLength = (int32_t) strtol(pSep + 1, &pEnd, 10);
-            if (*pEnd != '\0') {
-                *pSep = cSep;
-                appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-                continue;
-            }
+            ffStrbufSubstrBefore(&tempString, (uint32_t) (!ellipsis ? truncLength : truncLength - 1));
+        }
+        ffStrbufAppend(buffer, &tempString);
 
-            bool ellipsis = false;
-            if (truncLength < 0) {
-                ellipsis = true;
-                truncLength = -truncLength;
-            }
+        if (ellipsis) {
+            ffStrbufAppendS(buffer, "…");
+        }
+    } else if (cSep == ':') {
+        ffStrbufAppend(buffer, &tempString);
+    } else {
+        if (cSep == '<') { // left align
+            ffStrbufAppend(buffer, &tempString);
+            ffStrbufAppendNC(buffer, (uint32_t) truncLength - tempString.length, ' ');
+        } else if (cSep == '>') { // right align
+            ffStrbufAppendNC(buffer, (uint32_t) truncLength - tempString.length, ' ');
+            ffStrbufAppend(buffer, &tempString);
+        } else if (cSep == '|') { // center align
+            uint32_t padding = ((uint32_t) truncLength - tempString.length) / 2;
+            ffStrbufAppendNC(buffer, padding, ' ');
+            ffStrbufAppend(buffer, &tempString);
+            ffStrbufAppendNC(buffer, (uint32_t) truncLength - tempString.length - padding, ' ');
+        }
+    }
+
+    if (trailingEscape.length > 0) {
+        ffStrbufAppend(buffer, &trailingEscape);
+    }
+}
 
-            FF_STRBUF_AUTO_DESTROY tempString = ffStrbufCreate();
-            ffFormatAppendFormatArg(&tempString, &arguments[index - 1]);
-            FF_STRBUF_AUTO_DESTROY trailingEscape = ffStrbufCreate();
-            skipAnsiEscape(&tempString, buffer, &trailingEscape);
-
-            if (tempString.length == (uint32_t) truncLength) {
-                ffStrbufAppend(buffer, &tempString);
-            } else if (tempString.length > (uint32_t) truncLength) {
-                if (cSep == ':') {
-                    ffStrbufSubstrBefore(&tempString, (uint32_t) truncLength);
-                    ffStrbufTrimRightSpace(&tempString);
+static void runFormatProgram(FFstrbuf* buffer, FFFormatProgram* program, uint32_t numArgs, const FFformatarg* arguments) {
+    uint32_t argCounter = 0;
+
+    uint32_t numOpenIfs = 0;
+    uint32_t numOpenNotIfs = 0;
+
+    for (uint32_t pc = 0; pc < program->ops.length; ++pc) {
+        FFFormatOp* op = FF_LIST_GET(FFFormatOp, program->ops, pc);
+
+        switch (op->type) {
+            case FF_FORMAT_OP_LITERAL:
+                appendSpan(buffer, program, op->text);
+                break;
+
+            case FF_FORMAT_OP_COLOR:
+                if (!instance.config.display.pipe) {
+                    appendSpan(buffer, program, op->text);
+                }
+                break;
+
+            case FF_FORMAT_OP_STOP:
+                pc = program->ops.length;
+                break;
+
+            case FF_FORMAT_OP_END_IF:
+                if (numOpenIfs == 0) {
+                    appendSpan(buffer, program, op->invalid);
                 } else {
-                    ffStrbufSubstrBefore(&tempString, (uint32_t) (!ellipsis ? truncLength : truncLength - 1));
+                    --numOpenIfs;
                 }
-                ffStrbufAppend(buffer, &tempString);
+                break;
 
-                if (ellipsis) {
-                    ffStrbufAppendS(buffer, "…");
+            case FF_FORMAT_OP_END_IF_NOT:
+                if (numOpenNotIfs == 0) {
+                    appendSpan(buffer, program, op->invalid);
+                } else {
+                    --numOpenNotIfs;
                 }
-            } else if (cSep == ':') {
-                ffStrbufAppend(buffer, &tempString);
-            } else {
-                if (cSep == '<') { // left align
-                    ffStrbufAppend(buffer, &tempString);
-                    ffStrbufAppendNC(buffer, (uint32_t) truncLength - tempString.length, ' ');
-                } else if (cSep == '>') { // right align
-                    ffStrbufAppendNC(buffer, (uint32_t) truncLength - tempString.length, ' ');
-                    ffStrbufAppend(buffer, &tempString);
-                } else if (cSep == '|') { // center align
-                    uint32_t padding = ((uint32_t) truncLength - tempString.length) / 2;
-                    ffStrbufAppendNC(buffer, padding, ' ');
-                    ffStrbufAppend(buffer, &tempString);
-                    ffStrbufAppendNC(buffer, (uint32_t) truncLength - tempString.length - padding, ' ');
+                break;
+
+            case FF_FORMAT_OP_IF:
+            case FF_FORMAT_OP_IF_NOT: {
+                uint32_t index = resolveArgRef(program, &op->arg, numArgs, arguments);
+                if (index > numArgs || index < 1) {
+                    appendSpan(buffer, program, op->invalid);
+                    break;
+                }
+
+                // continue normally if the condition holds, otherwise fastforward to the end of the if
+                bool set = formatArgSet(&arguments[index - 1]);
+                if (op->type == FF_FORMAT_OP_IF && set) {
+                    ++numOpenIfs;
+                } else if (op->type == FF_FORMAT_OP_IF_NOT && !set) {
+                    ++numOpenNotIfs;
+                } else {
+                    pc = op->jump - 1; // the loop increments it again
                 }
+                break;
             }
 
-            if (trailingEscape.length > 0) {
-                ffStrbufAppend(buffer, &trailingEscape);
+            case FF_FORMAT_OP_CONSTANT: {
+                uint32_t index = (uint32_t) (op->num1 < 0 ? (int32_t) instance.config.display.constants.length + op->num1 : op->num1 - 1);
+                if (instance.config.display.constants.length <= index) {
+                    appendSpan(buffer, program, op->invalid);
+                } else {
+                    ffStrbufAppend(buffer, FF_LIST_GET(FFstrbuf, instance.config.display.constants, index));
+                }
+                break;
+            }
+
+            case FF_FORMAT_OP_ENV: {
+                const char* envValue = getenv(program->pool.chars + op->text.offset);
+                if (envValue) {
+                    ffStrbufAppendS(buffer, envValue);
+                } else {
+                    appendSpan(buffer, program, op->invalid);
+                }
+                break;
+            }
+
+            case FF_FORMAT_OP_ARG: {
+                uint32_t index = resolveArgRef(program, &op->arg, numArgs, arguments);
+                if (index == 0) {
+                    index = ++argCounter;
+                }
+
+                if (index > numArgs || op->sep == 'x') {
+                    appendSpan(buffer, program, op->invalid);
+                } else if (op->sep == '\0') {
+                    ffFormatAppendFormatArg(buffer, &arguments[index - 1]);
+                } else if (op->sep == '~') {
+                    appendSlice(buffer, program, op, &arguments[index - 1]);
+                } else {
+                    appendTruncated(buffer, op, &arguments[index - 1]);
+                }
+                break;
             }
         }
     }
@@ -739,7 +1016,36 @@ static bool parseFormatString(FFstrbuf* buffer, const FFstrbuf* formatstr, uint3
     if (!instance.config.display.pipe) {
         ffStrbufAppendS(buffer, FASTFETCH_TEXT_MODIFIER_RESET);
     }
+}
+
+static void destroyFormatProgram(FFFormatProgram* program) {
+    ffStrbufDestroy(&program->source);
+    ffStrbufDestroy(&program->pool);
+    ffListDestroy(&program->ops);
+}
 
+static bool parseFormatString(FFstrbuf* buffer, const FFstrbuf* formatstr, uint32_t numArgs, const FFformatarg* arguments) {
+    uint64_t hash = hashFormatString(formatstr->length, formatstr->chars);
+
+    FF_LIST_FOR_EACH (FFFormatProgram, program, programs) {
+        if (program->hash == hash && ffStrbufEqual(&program->source, formatstr)) {
+            runFormatProgram(buffer, program, numArgs, arguments);
+            return true;
+        }
+    }
+
+    FFFormatProgram temp = { .hash = hash };
+    FFFormatProgram* program = programs.length < FF_FORMAT_MAX_PROGRAMS ? FF_LIST_ADD(FFFormatProgram, programs) : &temp;
+    program->hash = hash;
+    ffStrbufInitNS(&program->source, formatstr->length, formatstr->chars);
+    ffStrbufInit(&program->pool);
+    ffListInit(&program->ops);
+    compileFormatString(program, numArgs, arguments);
+
+    runFormatProgram(buffer, program, numArgs, arguments);
+    if (program == &temp) {
+        destroyFormatProgram(&temp);
+    }
     return true;
 }
 
@@ -0,0 +1,167 @@
+#include "fastfetch.h"
+#include "common/frame.h"
+
+#ifndef _WIN32
+
+    #include <errno.h>
+    #include <stdlib.h>
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+
+    // `stdout` is an assignable variable, so stdio output can be collected with `open_memstream`
+    #if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+        #define FF_FRAME_CAPTURE 1
+    #endif
+
+static struct {
+    bool atexitRegistered;
+    FILE* output; // The original `stdout`; non-NULL only while a frame is captured
+    FILE* capture;
+    char* captureBuffer;
+    size_t captureSize;
+    FFstrbuf current;
+    FFstrbuf previous; // Last frame written in `--dynamic-interval` mode
+    uint32_t count;    // Number of frames captured and written
+} frame;
+
+void ffFrameBegin(void) {
+    #ifdef FF_FRAME_CAPTURE
+    // Only dynamic mode needs the content of a frame; otherwise the stdio buffer holds it
+    if (instance.state.dynamicInterval == 0 || instance.config.display.noBuffer || instance.config.display.pipe || frame.output) {
+        return;
+    }
+
+    fflush(stdout);
+    FILE* capture = open_memstream(&frame.captureBuffer, &frame.captureSize);
+    if (!capture) {
+        return;
+    }
+
+    if (!frame.atexitRegistered) {
+        frame.atexitRegistered = true;
+        ffStrbufInit(&frame.current);
+        ffStrbufInit(&frame.previous);
+        atexit(ffFrameEnd); // Don't lose what has been printed so far if `exit()` is called in the middle of a frame
+    }
+
+    frame.output = stdout;
+    frame.capture = capture;
+    stdout = capture;
+    #endif
+}
+
+void ffFrameSuspend(FF_A_UNUSED bool suspend) {
+    #ifdef FF_FRAME_CAPTURE
+    if (!frame.output) {
+        return;
+    }
+
+    if (suspend && stdout == frame.capture) {
+        fflush(frame.capture);
+        stdout = frame.output;
+    } else if (!suspend && stdout == frame.output) {
+        fflush(frame.output);
+        stdout = frame.capture;
+    }
+    #endif
+}
+
+static uint32_t countLines(const FFstrbuf* buffer) {
+    uint32_t count = 0;
+    for (const char* p = buffer->chars; (p = memchr(p, '\n', (size_t) (buffer->chars + buffer->length - p))) != NULL; ++p) {
+        ++count;
+    }
+    return count;
+}
+
+// Every frame is drawn from the top left corner of the alternate screen.
+// Rewrite only the lines that differ from the previous frame, using absolute cursor positioning
+static void composeRedraw(FFstrbuf* output) {
+    // Lines must map to screen rows: no line wrapping, and no scrolling
+    struct winsize winsize = {};
+    if (frame.count == 0) {
+        // The first frame continues after the logo, which is printed outside of it
+        ffStrbufAppend(output, &frame.current);
+        return;
+    }
+    // The first frame doesn't start at the top left corner, so its lines can't be compared to screen rows
+    if (frame.count == 1 || instance.config.display.pipe || !instance.config.display.disableLinewrap ||
+        ioctl(STDOUT_FILENO, TIOCGWINSZ, &winsize) < 0 ||
+        countLines(&frame.current) >= winsize.ws_row || countLines(&frame.previous) >= winsize.ws_row) {
+        ffStrbufAppendS(output, "\e[H");
+        ffStrbufAppend(output, &frame.current);
+        return;
+    }
+
+    const char* curr = frame.current.chars;
+    const char* currEnd = curr + frame.current.length;
+    const char* prev = frame.previous.chars;
+    const char* prevEnd = prev + frame.previous.length;
+    uint32_t row = 1;
+
+    for (const char* currEol; (currEol = memchr(curr, '\n', (size_t) (currEnd - curr))) != NULL; ++row) {
+        const char* prevEol = prev ? memchr(prev, '\n', (size_t) (prevEnd - prev)) : NULL;
+        size_t length = (size_t) (currEol - curr);
+        // An empty line writes nothing; e.g. the logo, which is printed in the first frame only
+        if (length > 0 && (!prevEol || (size_t) (prevEol - prev) != length || memcmp(prev, curr, length) != 0)) {
+            ffStrbufAppendF(output, "\e[%u;1H", row);
+            ffStrbufAppendNS(output, (uint32_t) length, curr);
+        }
+        curr = currEol + 1;
+        prev = prevEol ? prevEol + 1 : NULL;
+    }
+
+    // The rest, normally `\e[J`, which clears the lines left over from a taller previous frame
+    ffStrbufAppendF(output, "\e[%u;1H", row);
+    ffStrbufAppendNS(output, (uint32_t) (currEnd - curr), curr);
+}
+
+static void writeAll(const FFstrbuf* output) {
+    const char* data = output->chars;
+    size_t remaining = output->length;
+    while (remaining > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += written;
+        remaining -= (size_t) written;
+    }
+}
+
+void ffFrameEnd(void) {
+    if (!frame.output) {
+        fflush(stdout);
+        return;
+    }
+
+    stdout = frame.output;
+    frame.output = NULL;
+    fclose(frame.capture);
+    ffStrbufSetNS(&frame.current, (uint32_t) frame.captureSize, frame.captureBuffer);
+    free(frame.captureBuffer);
+    frame.captureBuffer = NULL;
+
+    FF_STRBUF_AUTO_DESTROY output = ffStrbufCreate();
+    composeRedraw(&output);
+    fflush(stdout);
+    writeAll(&output);
+
+    ++frame.count;
+    FFstrbuf temp = frame.previous;
+    frame.previous = frame.current;
+    frame.current = temp;
+}
+
+#else
+
+void ffFrameBegin(void) {}
+
+void ffFrameEnd(void) {}
+
+void ffFrameSuspend(FF_A_UNUSED bool suspend) {}
+
+#endif
@@ -1,7 +1,10 @@
 #include "fastfetch.h"
 #include "common/init.h"
+#include "common/frame.h"
 #include "common/parsing.h"
+#include "common/resultcache.h"
 #include "common/thread.h"
+#include "common/trace.h"
 #include "common/textModifier.h"
 #include "common/strutil.h"
 #include "detection/displayserver/displayserver.h"
@@ -30,11 +33,15 @@ static void initState(FFstate* state) {
     state->terminalLightTheme = false;
     state->titleFqdn = false;
 
-    ffPlatformInit(&state->platform);
+    {
+        FF_TRACE_SPAN(span, "init", "ffPlatformInit");
+        ffPlatformInit(&state->platform);
+    }
     state->dynamicInterval = 0;
 
     #if !FF_MODULE_DISABLE_TERMINALTHEME
     {
+        FF_TRACE_SPAN(span, "init", "ffDetectTerminalTheme");
         // don't enable bright color if the terminal is in light mode
         FFTerminalThemeResult result;
         if (ffDetectTerminalTheme(&result, true /* forceEnv for performance */) && !result.bg.dark) {
@@ -87,6 +94,8 @@ static volatile bool ffDisableLinewrap = false;
 static volatile bool ffHideCursor = false;
 
 static void resetConsole(void) {
+    ffFrameEnd();
+
     if (ffDisableLinewrap) {
         fputs("\033[?7h", stdout);
     }
@@ -131,6 +140,8 @@ void ffStart(void) {
 #else
     if (instance.config.display.noBuffer) {
         setvbuf(stdout, NULL, _IONBF, 0);
+    } else {
+        setvbuf(stdout, NULL, _IOFBF, 1 << 16); // Holds a whole frame, which `ffFrameEnd` flushes at once; don't flush every line
     }
     struct sigaction action;
     sigemptyset(&action.sa_mask);
@@ -179,8 +190,10 @@ static void destroyState(void) {
 }
 
 void ffDestroyInstance(void) {
+    ffResultCacheSave();
     destroyConfig();
     destroyState();
+    ffTraceSave();
 }
 
 #if FF_HAVE_LUA
@@ -1,5 +1,6 @@
 #include "common/io.h"
 #include "fastfetch.h"
+#include "common/frame.h"
 #include "common/strutil.h"
 #include "common/time.h"
 
@@ -50,6 +51,28 @@ bool ffWriteFileData(const char* fileName, size_t dataSize, const void* data) {
     return write(fd, data, dataSize) > 0;
 }
 
+bool ffWriteFileDataAtomic(const char* fileName, size_t dataSize, const void* data) {
+    FF_STRBUF_AUTO_DESTROY tempName = ffStrbufCreateF("%s.%u.tmp", fileName, instance.state.platform.pid);
+
+    int openFlagsModes = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    int fd = open(tempName.chars, openFlagsModes, S_IRUSR | S_IWUSR);
+    if (fd == -1 && errno == ENOENT) {
+        createSubfolders(tempName.chars);
+        fd = open(tempName.chars, openFlagsModes, S_IRUSR | S_IWUSR);
+    }
+    if (fd == -1) {
+        return false;
+    }
+
+    bool ok = write(fd, data, dataSize) == (ssize_t) dataSize;
+    close(fd);
+    if (!ok || rename(tempName.chars, fileName) != 0) {
+        unlink(tempName.chars);
+        return false;
+    }
+    return true;
+}
+
 static inline void readWithLength(int fd, FFstrbuf* buffer, uint32_t length) {
     ffStrbufEnsureFixedLengthFree(buffer, length);
     ssize_t bytesRead = 0;
@@ -223,31 +246,45 @@ bool ffSuppressIO(bool suppress) {
     }
 #endif
 
-    static bool init = false;
+    static uint32_t depth = 0;
     static int origOut = -1;
     static int origErr = -1;
     static int nullFile = -1;
 
-    if (!init) {
-        if (!suppress) {
+    if (!suppress) {
+        if (depth == 0 || --depth > 0) {
             return true;
         }
 
-        origOut = dup(STDOUT_FILENO);
-        origErr = dup(STDERR_FILENO);
-        nullFile = open("/dev/null", O_WRONLY | O_CLOEXEC);
-        init = true;
+        fflush(stdout);
+        fflush(stderr);
+        dup2(origOut, STDOUT_FILENO);
+        dup2(origErr, STDERR_FILENO);
+        close(origOut);
+        close(origErr);
+        ffFrameSuspend(false);
+        return true;
     }
 
     if (nullFile == -1) {
-        return false;
+        nullFile = open("/dev/null", O_WRONLY | O_CLOEXEC);
+        if (nullFile == -1) {
+            return false;
+        }
+    }
+
+    if (depth++ > 0) {
+        return true;
     }
 
+    ffFrameSuspend(true); // Library output written with stdio must not end up in the frame
     fflush(stdout);
     fflush(stderr);
 
-    dup2(suppress ? nullFile : origOut, STDOUT_FILENO);
-    dup2(suppress ? nullFile : origErr, STDERR_FILENO);
+    origOut = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 3);
+    origErr = fcntl(STDERR_FILENO, F_DUPFD_CLOEXEC, 3);
+    dup2(nullFile, STDOUT_FILENO);
+    dup2(nullFile, STDERR_FILENO);
     return true;
 }
 
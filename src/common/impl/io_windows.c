@@ -176,6 +176,18 @@ bool ffWriteFileData(const char* fileName, size_t dataSize, const void* data) {
     return !!WriteFile(handle, data, (DWORD) dataSize, &written, NULL);
 }
 
+bool ffWriteFileDataAtomic(const char* fileName, size_t dataSize, const void* data) {
+    FF_STRBUF_AUTO_DESTROY tempName = ffStrbufCreateF("%s.%u.tmp", fileName, instance.state.platform.pid);
+    if (!ffWriteFileData(tempName.chars, dataSize, data)) {
+        return false;
+    }
+    if (!MoveFileExA(tempName.chars, fileName, MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileA(tempName.chars);
+        return false;
+    }
+    return true;
+}
+
 static inline void readWithLength(HANDLE handle, FFstrbuf* buffer, uint32_t length) {
     ffStrbufEnsureFree(buffer, length);
     DWORD bytesRead = 0;
@@ -3,7 +3,9 @@
 #include "common/jsonconfig.h"
 #include "common/printing.h"
 #include "common/io.h"
+#include "common/moduleresult.h"
 #include "common/time.h"
+#include "common/trace.h"
 #include "common/strutil.h"
 #include "detection/version/version.h"
 #include "modules/modules.h"
@@ -101,7 +103,19 @@ static bool parseModuleJsonObject(const char* type, yyjson_val* jsonVal, yyjson_
                 baseInfo->parseJsonObject(optionBuf, jsonVal);
             }
             bool succeeded;
-            if (jsonDoc) {
+            if (baseInfo->detectResult) {
+                FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+                ffModuleResultGenerateKey(jsonVal, &key);
+                void* result;
+                const char* error = ffModuleResultDetect(baseInfo, optionBuf, key.chars, &result);
+                if (jsonDoc) {
+                    yyjson_mut_val* module = yyjson_mut_arr_add_obj(jsonDoc, jsonDoc->root);
+                    yyjson_mut_obj_add_str(jsonDoc, module, "type", baseInfo->name);
+                    succeeded = baseInfo->generateJsonResultFrom(optionBuf, error, result, jsonDoc, module);
+                } else {
+                    succeeded = baseInfo->printResult(optionBuf, error, result);
+                }
+            } else if (jsonDoc) {
                 yyjson_mut_val* module = yyjson_mut_arr_add_obj(jsonDoc, jsonDoc->root);
                 yyjson_mut_obj_add_str(jsonDoc, module, "type", baseInfo->name);
                 if (baseInfo->generateJsonResult) {
@@ -165,6 +179,16 @@ static void prepareModuleJsonObject(const char* type, yyjson_val* module) {
         }
         #endif
 
+        #if !FF_MODULE_DISABLE_EDITOR
+        case 'e':
+        case 'E': {
+            if (ffStrEqualsIgnCase(type, FF_EDITOR_MODULE_NAME)) {
+                ffPrepareEditor();
+            }
+            break;
+        }
+        #endif
+
         #if !FF_MODULE_DISABLE_NETIO
         case 'n':
         case 'N': {
@@ -180,9 +204,20 @@ static void prepareModuleJsonObject(const char* type, yyjson_val* module) {
         }
         #endif
 
-        #if !FF_MODULE_DISABLE_PUBLICIP
+        #if !FF_MODULE_DISABLE_PACKAGES || !FF_MODULE_DISABLE_PUBLICIP
         case 'p':
         case 'P': {
+            #if !FF_MODULE_DISABLE_PACKAGES
+            if (ffStrEqualsIgnCase(type, FF_PACKAGES_MODULE_NAME)) {
+                FF_A_CLEANUP(ffDestroyPackagesOptions) FFPackagesOptions options;
+                ffInitPackagesOptions(&options);
+                if (module) {
+                    ffPackagesModuleInfo.parseJsonObject(&options, module);
+                }
+                ffPreparePackages(&options);
+            }
+            #endif
+            #if !FF_MODULE_DISABLE_PUBLICIP
             if (ffStrEqualsIgnCase(type, FF_PUBLICIP_MODULE_NAME)) {
                 FF_A_CLEANUP(ffDestroyPublicIpOptions) FFPublicIPOptions options;
                 ffInitPublicIpOptions(&options);
@@ -191,6 +226,7 @@ static void prepareModuleJsonObject(const char* type, yyjson_val* module) {
                 }
                 ffPreparePublicIp(&options);
             }
+            #endif
             break;
         }
         #endif
@@ -256,8 +292,10 @@ static const char* printJsonConfig(FFdata* data, bool prepare) {
     size_t idx, max;
     yyjson_arr_foreach (modules, idx, max, item) {
         double ms = 0;
+        uint32_t allocs = 0;
         if (!prepare && thres >= 0) {
             ms = ffTimeGetTick();
+            allocs = ffAllocCountGet();
         }
 
         yyjson_val* module = item;
@@ -317,6 +355,7 @@ static const char* printJsonConfig(FFdata* data, bool prepare) {
             continue;
         }
 
+        FF_TRACE_SPAN(span, prepare ? "prepare" : "module", type);
         if (prepare) {
             prepareModuleJsonObject(type, module);
         } else {
@@ -325,15 +364,17 @@ static const char* printJsonConfig(FFdata* data, bool prepare) {
 
         if (!prepare && thres >= 0) {
             ms = ffTimeGetTick() - ms;
+            allocs = ffAllocCountGet() - allocs;
             if (jsonDoc) {
                 yyjson_mut_val* moduleJson = yyjson_mut_arr_get_last(jsonDoc->root);
                 yyjson_mut_obj_add_real(jsonDoc, moduleJson, "stat", ms);
+                yyjson_mut_obj_add_uint(jsonDoc, moduleJson, "allocs", allocs);
             } else {
                 char str[64];
-                int len = snprintf(str, sizeof str, "%.3fms", ms);
+                int len = snprintf(str, sizeof str, "%u allocs, %.3fms", allocs, ms);
                 if (thres > 0) {
-                    snprintf(str, sizeof str, "\e[%sm%.3fms\e[m", (ms <= thres ? FF_COLOR_FG_GREEN : ms <= 2 * thres ? FF_COLOR_FG_YELLOW
-                                                                                                                     : FF_COLOR_FG_RED),
+                    snprintf(str, sizeof str, "%u allocs, \e[%sm%.3fms\e[m", allocs, (ms <= thres ? FF_COLOR_FG_GREEN : ms <= 2 * thres ? FF_COLOR_FG_YELLOW
+                                                                                                                               : FF_COLOR_FG_RED),
                         ms);
                 }
                 printf("\e7\e[1A\e[9999999C\e[%dD%s\e8", len - 1, str); // Save; Up 1; Right 9999999; Left <len - 1>; Print <str>; Load
@@ -353,6 +394,9 @@ static const char* printJsonConfig(FFdata* data, bool prepare) {
 void ffPrintJsonConfig(FFdata* data, bool prepare) {
     yyjson_mut_doc* jsonDoc = data->resultDoc;
     const char* error = printJsonConfig(data, prepare);
+    if (!prepare) {
+        ffModuleResultClear();
+    }
     if (error) {
         if (jsonDoc) {
             yyjson_mut_val* obj = yyjson_mut_obj(jsonDoc);
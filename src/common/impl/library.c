@@ -1,6 +1,7 @@
 #include "fastfetch.h"
 #include "common/library.h"
 #include "common/debug.h"
+#include "common/trace.h"
 
 #if _WIN32
     #include "common/windows/nt.h"
@@ -10,6 +11,11 @@
 
 #ifndef FF_DISABLE_DLOPEN
 
+    #include "common/io.h"
+    #include "common/resultcache.h"
+    #include "common/strutil.h"
+    #include "common/thread.h"
+
     #include <stdarg.h>
 
     // Clang doesn't define __SANITIZE_ADDRESS__ but defines __has_feature(address_sanitizer)
@@ -27,7 +33,21 @@
         #endif
     #endif
 
-static void* libraryLoad(const char* path, int maxVersion) {
+// Process-wide registry of dlopen results, including failures. Handles are never closed
+typedef struct FFLibraryEntry {
+    FFstrbuf path; // As passed to `ffLibraryLoad`
+    int maxVersion;
+    void* handle; // NULL if not found
+} FFLibraryEntry;
+
+static struct {
+    FFThreadMutex mutex;
+    FFlist entries; // List of FFLibraryEntry
+} registry = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+};
+
+static void* libraryProbe(const char* path, int maxVersion, FFstrbuf* resolved) {
     void* result = dlopen(path, FF_DLOPEN_FLAGS);
 
     #if _WIN32
@@ -36,6 +56,7 @@ static void* libraryLoad(const char* path, int maxVersion) {
     FF_UNUSED(maxVersion)
 
     if (result != NULL) {
+        ffStrbufSetS(resolved, path);
         return result;
     }
 
@@ -46,15 +67,20 @@ static void* libraryLoad(const char* path, int maxVersion) {
 
     char absPath[MAX_PATH * 2];
     strcpy(mempcpy(absPath, instance.state.platform.exePath.chars, pathLen + 1), path);
-    return dlopen(absPath, FF_DLOPEN_FLAGS);
+    result = dlopen(absPath, FF_DLOPEN_FLAGS);
+    if (result != NULL) {
+        ffStrbufSetS(resolved, absPath);
+    }
 
     #else
 
-    if (result == NULL) {
-        FF_DEBUG("dlopen(\"%s\"): %s", path, dlerror());
+    if (result != NULL) {
+        ffStrbufSetS(resolved, path);
+        return result;
     }
 
-    if (result != NULL || maxVersion < 0) {
+    FF_DEBUG("dlopen(\"%s\"): %s", path, dlerror());
+    if (maxVersion < 0) {
         return result;
     }
 
@@ -68,6 +94,7 @@ static void* libraryLoad(const char* path, int maxVersion) {
 
         result = dlopen(pathbuf.chars, FF_DLOPEN_FLAGS);
         if (result != NULL) {
+            ffStrbufSet(resolved, &pathbuf);
             break;
         } else {
             FF_DEBUG("dlopen(\"%s\"): %s", pathbuf.chars, dlerror());
@@ -81,7 +108,72 @@ static void* libraryLoad(const char* path, int maxVersion) {
     return result;
 }
 
+// A library is only known to be missing until libraries are (un)installed, which we can only detect with ld.so.cache
+static bool canCacheFailure(void) {
+    #if _WIN32 || __APPLE__
+    return false;
+    #else
+    return !ffStrSet(getenv("LD_LIBRARY_PATH")) && ffPathExists("/etc/ld.so.cache", FF_PATHTYPE_FILE);
+    #endif
+}
+
+// Reuse the name resolved in a previous run, so that cold starts don't probe nonexistent versioned names
+static void* libraryLoadPersisted(const char* path, int maxVersion) {
+    if (!instance.config.general.resultCache) {
+        FF_STRBUF_AUTO_DESTROY resolved = ffStrbufCreate();
+        return libraryProbe(path, maxVersion, &resolved);
+    }
+
+    FF_STRBUF_AUTO_DESTROY name = ffStrbufCreate();
+    ffStrbufSetF(&name, "Library %s:%d", path, maxVersion);
+    const FFResultCacheKey keys[] = {
+        { .type = FF_RESULT_CACHE_KEY_FILE_MTIME, .path = "/etc/ld.so.cache" }, // Updated by ldconfig
+        {},
+    };
+
+    FF_STRBUF_AUTO_DESTROY resolved = ffStrbufCreate();
+    FFResultCacheReader reader;
+    if (ffResultCacheGet(name.chars, keys, &reader)) {
+        if (reader.remaining == 0) {
+            if (canCacheFailure()) {
+                FF_DEBUG("dlopen(\"%s\"): not found in previous run", path);
+                return NULL;
+            }
+        } else {
+            ffStrbufSetNS(&resolved, reader.remaining, reader.data);
+            void* result = dlopen(resolved.chars, FF_DLOPEN_FLAGS);
+            if (result != NULL) {
+                return result;
+            }
+            FF_DEBUG("dlopen(\"%s\"): %s", resolved.chars, dlerror()); // Removed since; probe again
+            ffStrbufClear(&resolved);
+        }
+    }
+
+    void* result = libraryProbe(path, maxVersion, &resolved);
+    if (result != NULL || canCacheFailure()) {
+        ffResultCacheSet(name.chars, keys, &resolved);
+    }
+    return result;
+}
+
+static void* libraryLoad(const char* path, int maxVersion) {
+    FF_LIST_FOR_EACH (FFLibraryEntry, entry, registry.entries) {
+        if (entry->maxVersion == maxVersion && ffStrbufEqualS(&entry->path, path)) {
+            return entry->handle;
+        }
+    }
+
+    FFLibraryEntry* entry = FF_LIST_ADD(FFLibraryEntry, registry.entries);
+    ffStrbufInitS(&entry->path, path);
+    entry->maxVersion = maxVersion;
+    entry->handle = libraryLoadPersisted(path, maxVersion);
+    return entry->handle;
+}
+
 void* ffLibraryLoad(const char* path, int maxVersion, ...) {
+    FF_TRACE_SPAN(span, "dlopen", path);
+    ffThreadMutexLock(&registry.mutex);
     void* result = libraryLoad(path, maxVersion);
 
     if (!result) {
@@ -101,6 +193,7 @@ void* ffLibraryLoad(const char* path, int maxVersion, ...) {
         va_end(defaultNames);
     }
 
+    ffThreadMutexUnlock(&registry.mutex);
     return result;
 }
 
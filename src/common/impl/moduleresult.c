@@ -0,0 +1,159 @@
+#include "fastfetch.h"
+#include "common/moduleresult.h"
+#include "common/resultcache.h"
+#include "common/time.h"
+#if defined(__linux__) || defined(__GNU__)
+    #include "common/proctable.h"
+#endif
+
+#include <stdalign.h>
+
+typedef struct FFModuleResultEntry {
+    const FFModuleBaseInfo* baseInfo;
+    FFstrbuf key;
+    const char* error;
+    void* result;
+    uint64_t detectTime;
+    uint32_t refreshInterval;
+} FFModuleResultEntry;
+
+static FFlist entries; // List of FFModuleResultEntry
+
+static const char* detectResult(const FFModuleBaseInfo* baseInfo, void* options, void* result) {
+    if (!baseInfo->cacheKeys || !instance.config.general.resultCache) {
+        return baseInfo->detectResult(options, result);
+    }
+
+    FFResultCacheReader reader;
+    if (ffResultCacheGet(baseInfo->name, baseInfo->cacheKeys, &reader)) {
+        if (baseInfo->deserializeResult(result, &reader)) {
+            return NULL;
+        }
+        baseInfo->destroyResult(result);
+        memset(result, 0, baseInfo->resultSize);
+    }
+
+    const char* error = baseInfo->detectResult(options, result);
+    if (!error) {
+        FF_STRBUF_AUTO_DESTROY data = ffStrbufCreate();
+        baseInfo->serializeResult(result, &data);
+        ffResultCacheSet(baseInfo->name, baseInfo->cacheKeys, &data);
+    }
+    return error;
+}
+
+bool ffModuleResultPrint(const FFModuleBaseInfo* baseInfo, void* options) {
+    assert(baseInfo->detectResult && baseInfo->resultSize <= FF_RESULT_MAX_SIZE);
+
+    alignas(max_align_t) uint8_t resultBuf[FF_RESULT_MAX_SIZE];
+    memset(resultBuf, 0, baseInfo->resultSize);
+    const char* error = detectResult(baseInfo, options, resultBuf);
+    bool succeeded = baseInfo->printResult(options, error, resultBuf);
+    baseInfo->destroyResult(resultBuf);
+    return succeeded;
+}
+
+bool ffModuleResultGenerateJson(const FFModuleBaseInfo* baseInfo, void* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    assert(baseInfo->detectResult && baseInfo->resultSize <= FF_RESULT_MAX_SIZE);
+
+    alignas(max_align_t) uint8_t resultBuf[FF_RESULT_MAX_SIZE];
+    memset(resultBuf, 0, baseInfo->resultSize);
+    const char* error = detectResult(baseInfo, options, resultBuf);
+    bool succeeded = baseInfo->generateJsonResultFrom(options, error, resultBuf, doc, module);
+    baseInfo->destroyResult(resultBuf);
+    return succeeded;
+}
+
+void ffModuleResultGenerateKey(yyjson_val* module, FFstrbuf* key) {
+    ffStrbufClear(key);
+    if (!module) {
+        return;
+    }
+
+    yyjson_val *k, *v;
+    size_t idx, max;
+    yyjson_obj_foreach (module, idx, max, k, v) {
+        // Properties parsed by `ffJsonConfigParseModuleArgs`, which only affect rendering
+        if (unsafe_yyjson_equals_str(k, "type") ||
+            unsafe_yyjson_equals_str(k, "condition") ||
+            unsafe_yyjson_equals_str(k, "key") ||
+            unsafe_yyjson_equals_str(k, "format") ||
+            unsafe_yyjson_equals_str(k, "outputColor") ||
+            unsafe_yyjson_equals_str(k, "keyColor") ||
+            unsafe_yyjson_equals_str(k, "keyWidth") ||
+            unsafe_yyjson_equals_str(k, "keyIcon")) {
+            continue;
+        }
+
+        size_t len;
+        char* json = yyjson_val_write(v, YYJSON_WRITE_NOFLAG, &len);
+        if (!json) {
+            continue;
+        }
+        ffStrbufAppendNS(key, (uint32_t) unsafe_yyjson_get_len(k), unsafe_yyjson_get_str(k));
+        ffStrbufAppendC(key, '=');
+        ffStrbufAppendNS(key, (uint32_t) len, json);
+        ffStrbufAppendC(key, ';');
+        free(json);
+    }
+}
+
+const char* ffModuleResultDetect(const FFModuleBaseInfo* baseInfo, void* options, const char* key, void** result) {
+    assert(baseInfo->detectResult && baseInfo->resultSize <= FF_RESULT_MAX_SIZE);
+
+    FF_LIST_FOR_EACH (FFModuleResultEntry, entry, entries) {
+        if (entry->baseInfo == baseInfo && ffStrbufEqualS(&entry->key, key)) {
+            *result = entry->result;
+            return entry->error;
+        }
+    }
+
+    FFModuleResultEntry* entry = FF_LIST_ADD(FFModuleResultEntry, entries);
+    entry->baseInfo = baseInfo;
+    ffStrbufInitS(&entry->key, key);
+    entry->result = calloc(1, baseInfo->resultSize);
+    entry->error = detectResult(baseInfo, options, entry->result);
+    entry->detectTime = ffTimeGetNow();
+    entry->refreshInterval = baseInfo->getRefreshInterval ? baseInfo->getRefreshInterval(options) : baseInfo->refreshInterval;
+    *result = entry->result;
+    return entry->error;
+}
+
+bool ffModuleResultIsKept(const FFModuleBaseInfo* baseInfo) {
+    FF_LIST_FOR_EACH (FFModuleResultEntry, entry, entries) {
+        if (entry->baseInfo == baseInfo) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool isOutdatedNextTick(const FFModuleResultEntry* entry, uint64_t now) {
+    if (instance.state.dynamicInterval == 0 || entry->refreshInterval == 0) {
+        return true;
+    }
+    if (entry->refreshInterval == FF_MODULE_REFRESH_NEVER) {
+        return false;
+    }
+    return now + instance.state.dynamicInterval - entry->detectTime >= entry->refreshInterval;
+}
+
+void ffModuleResultClear(void) {
+    uint64_t now = ffTimeGetNow();
+    uint32_t kept = 0;
+    FF_LIST_FOR_EACH (FFModuleResultEntry, entry, entries) {
+        if (isOutdatedNextTick(entry, now)) {
+            entry->baseInfo->destroyResult(entry->result);
+            free(entry->result);
+            ffStrbufDestroy(&entry->key);
+        } else {
+            *FF_LIST_GET(FFModuleResultEntry, entries, kept) = *entry;
+            ++kept;
+        }
+    }
+    entries.length = kept;
+
+#if defined(__linux__) || defined(__GNU__)
+    ffProcTableClear(); // Processes change between ticks
+#endif
+}
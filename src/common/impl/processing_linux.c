@@ -3,6 +3,7 @@
 #include "common/io.h"
 #include "common/strutil.h"
 #include "common/mallocHelper.h"
+#include "common/time.h"
 
 #include <stdlib.h>
 #include <unistd.h>
@@ -21,7 +22,9 @@
     #include <sys/user.h>
     #include <sys/sysctl.h>
 #endif
-#if defined(__APPLE__)
+#if defined(__linux__) || defined(__GNU__)
+    #include "common/proctable.h"
+#elif defined(__APPLE__)
     #include <libproc.h>
 #elif defined(__sun)
     #include <procfs.h>
@@ -56,8 +59,37 @@ static inline int ffPipe2(int* fds, int flags) {
 #endif
 }
 
-// Not thread-safe
+#if !(__ANDROID__ || __OpenBSD__)
+// Returns `environ` with LANG replaced by `C.UTF-8` for consistent output, or `environ` itself if no change is needed.
+// A private copy rather than patching `environ`, so that detection threads can spawn processes concurrently
+static char** createChildEnviron(void) {
+    uint32_t count = 0, langIndex = UINT32_MAX;
+    for (; environ[count] != NULL; ++count) {
+        if (langIndex == UINT32_MAX && ffStrStartsWith(environ[count], "LANG=")) {
+            langIndex = count;
+        }
+    }
+    if (langIndex == UINT32_MAX) {
+        return environ;
+    }
+
+    const char* langValue = environ[langIndex] + strlen("LANG=");
+    if (ffStrEqualsIgnCase(langValue, "C") ||
+        ffStrStartsWithIgnCase(langValue, "C.") ||
+        ffStrEqualsIgnCase(langValue, "en_US") ||
+        ffStrStartsWithIgnCase(langValue, "en_US.")) {
+        return environ; // No need to change LANG
+    }
+
+    char** result = malloc((count + 1) * sizeof(*result));
+    memcpy(result, environ, (count + 1) * sizeof(*result));
+    result[langIndex] = (char*) "LANG=C.UTF-8";
+    return result;
+}
+#endif
+
 const char* ffProcessSpawn(char* const argv[], bool useStdErr, FFProcessHandle* outHandle) {
+    FF_TRACE_SPAN(span, "process", argv[0]);
     int pipes[2];
     if (ffPipe2(pipes, O_CLOEXEC) == -1) {
         return "pipe() failed";
@@ -79,43 +111,10 @@ const char* ffProcessSpawn(char* const argv[], bool useStdErr, FFProcessHandle*
     posix_spawn_file_actions_adddup2(&file_actions, pipes[1], useStdErr ? STDERR_FILENO : STDOUT_FILENO);
     posix_spawn_file_actions_adddup2(&file_actions, nullFile, useStdErr ? STDOUT_FILENO : STDERR_FILENO);
 
-    static char* oldLang = NULL;
-    static int langIndex = -1;
-
-    if (langIndex >= 0) {
-        // Found before
-        if (oldLang) // oldLang was set only if it needed to be changed
-        {
-            if (environ[langIndex] != oldLang) {
-                // environ is changed outside of this function
-                langIndex = -1;
-            } else {
-                environ[langIndex] = (char*) "LANG=C.UTF-8";
-            }
-        }
-    }
-    if (langIndex < 0) {
-        for (int i = 0; environ[i] != NULL; i++) {
-            if (ffStrStartsWith(environ[i], "LANG=")) {
-                langIndex = i;
-                const char* langValue = environ[i] + 5; // Skip "LANG="
-                if (ffStrEqualsIgnCase(langValue, "C") ||
-                    ffStrStartsWithIgnCase(environ[i], "C.") ||
-                    ffStrEqualsIgnCase(langValue, "en_US") ||
-                    ffStrStartsWithIgnCase(langValue, "en_US.")) {
-                    break; // No need to change LANG
-                }
-                oldLang = environ[i];
-                environ[i] = (char*) "LANG=C.UTF-8"; // Set LANG to C.UTF-8 for consistent output
-                break;
-            }
-        }
-    }
-
-    int ret = posix_spawnp(&childPid, argv[0], &file_actions, NULL, argv, environ);
-
-    if (oldLang) {
-        environ[langIndex] = oldLang;
+    char** childEnviron = createChildEnviron();
+    int ret = posix_spawnp(&childPid, argv[0], &file_actions, NULL, argv, childEnviron);
+    if (childEnviron != environ) {
+        free(childEnviron);
     }
 
     posix_spawn_file_actions_destroy(&file_actions);
@@ -156,10 +155,32 @@ const char* ffProcessSpawn(char* const argv[], bool useStdErr, FFProcessHandle*
     return NULL;
 }
 
+// Called once the pipe is closed
+static const char* reapChildProcess(pid_t childPid) {
+    int stat_loc = 0;
+    if (childPid > 0 && waitpid(childPid, &stat_loc, 0) == childPid) {
+        if (!WIFEXITED(stat_loc)) {
+            return "child process exited abnormally";
+        }
+        if (WEXITSTATUS(stat_loc) == 127) {
+            return "command not found";
+        }
+        // We only handle 127 as an error. See `getTerminalVersionUrxvt` in `terminalshell.c`
+    }
+    return NULL;
+}
+
+static void killChildProcess(pid_t childPid) {
+    kill(childPid, SIGTERM);
+    waitpid(childPid, NULL, 0);
+}
+
 const char* ffProcessReadOutput(FFProcessHandle* handle, FFstrbuf* buffer) {
     assert(handle->pipeRead != -1);
     assert(handle->pid != -1);
 
+    FF_TRACE_SPAN(span, "process", "wait");
+    span.bytes = 0;
     const int32_t timeout = instance.config.general.processingTimeout;
     FF_AUTO_CLOSE_FD int childPipeFd = handle->pipeRead;
     pid_t childPid = handle->pid;
@@ -172,12 +193,10 @@ const char* ffProcessReadOutput(FFProcessHandle* handle, FFstrbuf* buffer) {
             struct pollfd pollfd = { childPipeFd, POLLIN, 0 };
             int pollret = poll(&pollfd, 1, timeout);
             if (pollret == 0) {
-                kill(childPid, SIGTERM);
-                waitpid(childPid, NULL, 0);
+                killChildProcess(childPid);
                 return "poll(&pollfd, 1, timeout) timeout (try increasing --processing-timeout)";
             } else if (pollret < 0 || (pollfd.revents & POLLERR)) {
-                kill(childPid, SIGTERM);
-                waitpid(childPid, NULL, 0);
+                killChildProcess(childPid);
                 return pollret < 0
                     ? "poll(&pollfd, 1, timeout) error: pollret < 0"
                     : "poll(&pollfd, 1, timeout) error: pollfd.revents & POLLERR";
@@ -187,19 +206,9 @@ const char* ffProcessReadOutput(FFProcessHandle* handle, FFstrbuf* buffer) {
         ssize_t nRead = read(childPipeFd, str, FF_PIPE_BUFSIZ);
         if (nRead > 0) {
             ffStrbufAppendNS(buffer, (uint32_t) nRead, str);
+            span.bytes += nRead;
         } else if (nRead == 0) {
-            int stat_loc = 0;
-            if (childPid > 0 && waitpid(childPid, &stat_loc, 0) == childPid) {
-                if (!WIFEXITED(stat_loc)) {
-                    return "child process exited abnormally";
-                }
-                if (WEXITSTATUS(stat_loc) == 127) {
-                    return "command not found";
-                }
-                // We only handle 127 as an error. See `getTerminalVersionUrxvt` in `terminalshell.c`
-                return NULL;
-            }
-            return NULL;
+            return reapChildProcess(childPid);
         } else if (nRead < 0) {
             break;
         }
@@ -208,6 +217,124 @@ const char* ffProcessReadOutput(FFProcessHandle* handle, FFstrbuf* buffer) {
     return "read(childPipeFd, str, FF_PIPE_BUFSIZ) failed";
 }
 
+struct FFProcessFuture {
+    FFProcessHandle handle;
+    FFstrbuf output;
+    const char* error;
+    uint64_t deadline;
+    bool done;
+};
+
+static struct {
+    FFlist running; // List of FFProcessFuture*
+} processPool;
+
+static void finishFuture(FFProcessFuture* future, const char* error) {
+    close(future->handle.pipeRead);
+    future->handle.pipeRead = -1;
+    future->error = error;
+    future->done = true;
+}
+
+// Reads the pipes of all running futures until `target` is done
+static void pollFutures(const FFProcessFuture* target) {
+    const int32_t timeout = instance.config.general.processingTimeout;
+    FF_LIST_AUTO_DESTROY pollfds = ffListCreate();
+    char str[FF_PIPE_BUFSIZ];
+
+    while (!target->done) {
+        ffListClear(&pollfds);
+        uint64_t deadline = UINT64_MAX;
+        FF_LIST_FOR_EACH (FFProcessFuture*, pFuture, processPool.running) {
+            *FF_LIST_ADD(struct pollfd, pollfds) = (struct pollfd) { (*pFuture)->handle.pipeRead, POLLIN, 0 };
+            if ((*pFuture)->deadline < deadline) {
+                deadline = (*pFuture)->deadline;
+            }
+        }
+
+        int pollTimeout = -1;
+        if (timeout >= 0) {
+            uint64_t now = ffTimeGetNow();
+            pollTimeout = now >= deadline ? 0 : (int) (deadline - now);
+        }
+
+        int pollret = poll((struct pollfd*) pollfds.data, (nfds_t) pollfds.length, pollTimeout);
+        if (pollret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            FF_LIST_FOR_EACH (FFProcessFuture*, pFuture, processPool.running) {
+                killChildProcess((*pFuture)->handle.pid);
+                finishFuture(*pFuture, "poll() failed");
+            }
+            processPool.running.length = 0;
+            return;
+        }
+
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < pollfds.length; ++i) {
+            FFProcessFuture* future = *FF_LIST_GET(FFProcessFuture*, processPool.running, i);
+            short revents = FF_LIST_GET(struct pollfd, pollfds, i)->revents;
+            if (revents & (POLLIN | POLLHUP)) {
+                ssize_t nRead = read(future->handle.pipeRead, str, FF_PIPE_BUFSIZ);
+                if (nRead > 0) {
+                    ffStrbufAppendNS(&future->output, (uint32_t) nRead, str);
+                } else if (nRead == 0) {
+                    finishFuture(future, reapChildProcess(future->handle.pid));
+                } else if (errno != EINTR && errno != EAGAIN) {
+                    killChildProcess(future->handle.pid);
+                    finishFuture(future, "read(childPipeFd, str, FF_PIPE_BUFSIZ) failed");
+                }
+            } else if (revents & (POLLERR | POLLNVAL)) {
+                killChildProcess(future->handle.pid);
+                finishFuture(future, "poll() error: pollfd.revents & POLLERR");
+            } else if (timeout >= 0 && ffTimeGetNow() >= future->deadline) {
+                // Only idle processes time out, so output written before the deadline is still drained
+                killChildProcess(future->handle.pid);
+                finishFuture(future, "poll() timeout (try increasing --processing-timeout)");
+            }
+
+            if (!future->done) {
+                *FF_LIST_GET(FFProcessFuture*, processPool.running, kept) = future;
+                ++kept;
+            }
+        }
+        processPool.running.length = kept;
+    }
+}
+
+const char* ffProcessSpawnAsync(char* const argv[], bool useStdErr, FFProcessFuture** outFuture) {
+    FFProcessHandle handle;
+    const char* error = ffProcessSpawn(argv, useStdErr, &handle);
+    if (error) {
+        return error;
+    }
+
+    FFProcessFuture* future = malloc(sizeof(*future));
+    future->handle = handle;
+    ffStrbufInit(&future->output);
+    future->error = NULL;
+    future->deadline = ffTimeGetNow() + (uint64_t) instance.config.general.processingTimeout;
+    future->done = false;
+    *FF_LIST_ADD(FFProcessFuture*, processPool.running) = future;
+    *outFuture = future;
+    return NULL;
+}
+
+const char* ffProcessFutureGet(FFProcessFuture* future, FFstrbuf* buffer) {
+    FF_TRACE_SPAN(span, "process", "wait");
+    if (!future->done) {
+        pollFutures(future);
+    }
+    span.bytes = future->output.length;
+
+    const char* error = future->error;
+    ffStrbufAppend(buffer, &future->output);
+    ffStrbufDestroy(&future->output);
+    free(future);
+    return error;
+}
+
 void ffProcessGetInfoLinux(pid_t pid, FFstrbuf* processName, FFstrbuf* exe, const char** exeName, FFstrbuf* exePath) {
     assert(processName->length > 0);
     ffStrbufClear(exe);
@@ -475,6 +602,19 @@ const char* ffProcessGetBasicInfoLinux(pid_t pid, FFstrbuf* name, pid_t* ppid, i
 
 #if defined(__linux__) || defined(__GNU__)
 
+    // Reuse the process snapshot if another module has taken one
+    const FFProcTableEntry* entry = ffProcTableFind(pid);
+    if (entry && entry->comm[0]) {
+        ffStrbufSetS(name, entry->comm);
+        if (ppid) {
+            *ppid = entry->ppid;
+        }
+        if (tty) {
+            *tty = entry->tty & 0xFF;
+        }
+        return NULL;
+    }
+
     char procFilePath[64];
     #if __linux__
     if (ppid || tty)
@@ -49,11 +49,12 @@ static void argvToCmdline(char* const argv[], FFstrbuf* result) {
 }
 
 const char* ffProcessSpawn(char* const argv[], bool useStdErr, FFProcessHandle* outHandle) {
+    FF_TRACE_SPAN(span, "process", argv[0]);
     const int32_t timeout = instance.config.general.processingTimeout;
 
     wchar_t pipeName[32];
     static unsigned pidCounter = 0;
-    swprintf(pipeName, ARRAY_SIZE(pipeName), L"\\\\.\\pipe\\FASTFETCH-%u-%u", instance.state.platform.pid, ++pidCounter);
+    swprintf(pipeName, ARRAY_SIZE(pipeName), L"\\\\.\\pipe\\FASTFETCH-%u-%u", instance.state.platform.pid, __atomic_add_fetch(&pidCounter, 1, __ATOMIC_RELAXED)); // May be called from detection threads
 
     FF_AUTO_CLOSE_FD HANDLE hChildPipeRead = CreateNamedPipeW(
         pipeName,
@@ -151,6 +152,8 @@ const char* ffProcessReadOutput(FFProcessHandle* handle, FFstrbuf* buffer) {
     assert(handle->pipeRead != INVALID_HANDLE_VALUE);
     assert(handle->pid != INVALID_HANDLE_VALUE);
 
+    FF_TRACE_SPAN(span, "process", "wait");
+    span.bytes = 0;
     int32_t timeout = instance.config.general.processingTimeout;
     FF_AUTO_CLOSE_FD HANDLE hProcess = handle->pid;
     FF_AUTO_CLOSE_FD HANDLE hChildPipeRead = handle->pipeRead;
@@ -204,6 +207,7 @@ const char* ffProcessReadOutput(FFProcessHandle* handle, FFstrbuf* buffer) {
 
         nRead = (uint32_t) iosb.Information;
         ffStrbufAppendNS(buffer, nRead, str);
+        span.bytes += nRead;
     } while (nRead > 0);
 
 exit: {
@@ -222,6 +226,30 @@ exit: {
     return NULL;
 }
 
+// Named pipes are buffered by the kernel, so children spawned up front keep running while another future is read.
+// Each read still waits for at most `--processing-timeout` ms
+struct FFProcessFuture {
+    FFProcessHandle handle;
+};
+
+const char* ffProcessSpawnAsync(char* const argv[], bool useStdErr, FFProcessFuture** outFuture) {
+    FFProcessHandle handle;
+    const char* error = ffProcessSpawn(argv, useStdErr, &handle);
+    if (error) {
+        return error;
+    }
+
+    *outFuture = malloc(sizeof(**outFuture));
+    (*outFuture)->handle = handle;
+    return NULL;
+}
+
+const char* ffProcessFutureGet(FFProcessFuture* future, FFstrbuf* buffer) {
+    const char* error = ffProcessReadOutput(&future->handle, buffer);
+    free(future);
+    return error;
+}
+
 bool ffProcessGetInfoWindows(uint32_t pid, uint32_t* ppid, FFstrbuf* pname, FFstrbuf* exe, const char** exeName, FFstrbuf* exePath, bool* gui) {
     FF_AUTO_CLOSE_FD HANDLE hProcess = NtCurrentProcess();
     if (pid != 0) {
@@ -0,0 +1,179 @@
+#include "fastfetch.h"
+#include "common/proctable.h"
+#include "common/io.h"
+#include "common/mallocHelper.h"
+#include "common/strutil.h"
+#include "common/thread.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+    #include <sys/syscall.h>
+#endif
+
+static struct {
+    FFThreadMutex mutex;
+    bool built; // Set with release semantics once `table` is complete
+    bool failed;
+    FFProcTable table;
+} snapshot = {
+#if FF_HAVE_THREADS
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+#endif
+};
+
+// Parse `/proc/pid/stat`: pid (comm) state ppid pgrp session tty_nr tpgid flags minflt cminflt majflt cmajflt utime stime cutime cstime priority nice num_threads ...
+static bool parseStat(char* buf, ssize_t nRead, FFProcTableEntry* entry) {
+    // comm is not encoded, and may contain ' ', ')' or even `\n`
+    char* start = memchr(buf, '(', (size_t) nRead);
+    if (!start) {
+        return false;
+    }
+    start++;
+    char* end = memrchr(start, ')', (size_t) nRead - (size_t) (start - buf));
+    if (!end || end + 4 > buf + nRead) {
+        return false;
+    }
+
+    char* commEnd = end;
+    while (commEnd > start && isspace((unsigned char) commEnd[-1])) {
+        --commEnd;
+    }
+    size_t commLength = (size_t) (commEnd - start);
+    if (commLength < sizeof(entry->comm)) {
+        memcpy(entry->comm, start, commLength);
+        entry->comm[commLength] = '\0';
+    } else {
+        entry->comm[0] = '\0';
+    }
+
+    char* p = end + 4; // skip ") S "
+    entry->ppid = (pid_t) strtol(p, &p, 10);
+    strtol(p, &p, 10); // pgrp
+    strtol(p, &p, 10); // session
+    entry->tty = (int32_t) strtol(p, &p, 10);
+    for (int i = 8; i < 20; ++i) { // tpgid .. nice
+        strtoll(p, &p, 10);
+    }
+    entry->threads = (uint32_t) strtoul(p, &p, 10);
+    return *p == ' ' || *p == '\n';
+}
+
+static void addProcess(int procFd, const char* name) {
+    if (!ffCharIsDigit(name[0])) {
+        return;
+    }
+
+    char path[32];
+    snprintf(path, sizeof(path), "%s/stat", name);
+    FF_AUTO_CLOSE_FD int fd = openat(procFd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return; // Exited in the meantime
+    }
+
+    char buf[512];
+    ssize_t nRead = read(fd, buf, sizeof(buf) - 1);
+    struct stat st;
+    if (nRead <= 8 || fstat(fd, &st) < 0) {
+        return;
+    }
+    buf[nRead] = '\0';
+
+    FFProcTableEntry* entry = FF_LIST_ADD(FFProcTableEntry, snapshot.table.entries);
+    entry->pid = (pid_t) strtol(name, NULL, 10);
+    entry->uid = st.st_uid;
+    if (!parseStat(buf, nRead, entry)) {
+        --snapshot.table.entries.length;
+        return;
+    }
+    snapshot.table.threads += entry->threads;
+}
+
+static int compareEntry(const void* a, const void* b) {
+    pid_t pa = ((const FFProcTableEntry*) a)->pid;
+    pid_t pb = ((const FFProcTableEntry*) b)->pid;
+    return (pa > pb) - (pa < pb);
+}
+
+static void buildTable(void) {
+    FF_TRACE_SPAN(span, "file", "/proc/*/stat");
+
+    FF_AUTO_CLOSE_FD int procFd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (procFd < 0) {
+        snapshot.failed = true;
+        return;
+    }
+
+#ifdef __linux__
+    // One getdents64 call returns hundreds of entries, unlike the small buffer of readdir
+    struct linux_dirent64 {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[];
+    };
+
+    FF_AUTO_FREE char* buf = malloc(64 * 1024);
+    for (long nRead; (nRead = syscall(SYS_getdents64, procFd, buf, 64 * 1024)) > 0;) {
+        for (long pos = 0; pos < nRead;) {
+            struct linux_dirent64* dirent = (struct linux_dirent64*) (buf + pos);
+            if (dirent->d_type == DT_DIR || dirent->d_type == DT_UNKNOWN) {
+                addProcess(procFd, dirent->d_name);
+            }
+            pos += dirent->d_reclen;
+        }
+    }
+#else
+    FF_AUTO_CLOSE_DIR DIR* dir = fdopendir(dup(procFd));
+    if (dir) {
+        struct dirent* dirent;
+        while ((dirent = readdir(dir)) != NULL) {
+            addProcess(procFd, dirent->d_name);
+        }
+    }
+#endif
+
+    if (snapshot.table.entries.length == 0) {
+        snapshot.failed = true;
+        return;
+    }
+
+    // procfs lists processes by pid already
+    for (uint32_t i = 1; i < snapshot.table.entries.length; ++i) {
+        if (FF_LIST_GET(FFProcTableEntry, snapshot.table.entries, i - 1)->pid > FF_LIST_GET(FFProcTableEntry, snapshot.table.entries, i)->pid) {
+            qsort(snapshot.table.entries.data, snapshot.table.entries.length, sizeof(FFProcTableEntry), compareEntry);
+            break;
+        }
+    }
+}
+
+const FFProcTable* ffProcTableGet(void) {
+    if (!__atomic_load_n(&snapshot.built, __ATOMIC_ACQUIRE)) {
+        ffThreadMutexLock(&snapshot.mutex);
+        if (!snapshot.built) {
+            buildTable();
+            __atomic_store_n(&snapshot.built, true, __ATOMIC_RELEASE);
+        }
+        ffThreadMutexUnlock(&snapshot.mutex);
+    }
+    return snapshot.failed ? NULL : &snapshot.table;
+}
+
+void ffProcTableClear(void) {
+    ffThreadMutexLock(&snapshot.mutex);
+    __atomic_store_n(&snapshot.built, false, __ATOMIC_RELEASE);
+    snapshot.failed = false;
+    ffListClear(&snapshot.table.entries);
+    snapshot.table.threads = 0;
+    ffThreadMutexUnlock(&snapshot.mutex);
+}
+
+const FFProcTableEntry* ffProcTableFind(pid_t pid) {
+    if (!__atomic_load_n(&snapshot.built, __ATOMIC_ACQUIRE) || snapshot.failed) {
+        return NULL;
+    }
+    return bsearch(&(FFProcTableEntry) { .pid = pid }, snapshot.table.entries.data, snapshot.table.entries.length, sizeof(FFProcTableEntry), compareEntry);
+}
@@ -0,0 +1,298 @@
+#include "fastfetch.h"
+#include "common/resultcache.h"
+#include "common/io.h"
+#include "common/path.h"
+#include "common/thread.h"
+#include "common/time.h"
+#include "detection/uptime/uptime.h"
+
+#include <inttypes.h>
+#include <sys/stat.h>
+
+// File layout: magic, fastfetch version, then (name, validators, data, lastUsed) entries.
+// Strings are written by `ffResultCacheWriteStrbuf`, lastUsed by `ffResultCacheWriteData`
+#define FF_RESULT_CACHE_MAGIC "FFRC2"
+// Entry names may contain paths (logo files, executables), so unused entries pile up. Keep the most recently used ones
+#define FF_RESULT_CACHE_MAX_ENTRIES 256
+
+typedef struct FFResultCacheEntry {
+    FFstrbuf name;
+    FFstrbuf validators; // Resolved invalidation keys
+    FFstrbuf data;
+    uint64_t lastUsed; // Unix time in ms of the last saved run that read or wrote the entry
+    bool used;         // Read or written in this run
+} FFResultCacheEntry;
+
+static struct {
+    FFThreadMutex mutex; // Libraries are loaded in worker threads too
+    bool loaded;
+    bool dirty;
+    FFlist entries; // List of FFResultCacheEntry
+} cache = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+};
+
+static void getCachePath(FFstrbuf* path) {
+    ffStrbufSet(path, &instance.state.platform.cacheDir);
+    ffStrbufEnsureEndsWithC(path, '/');
+    ffStrbufAppendS(path, "fastfetch/results.bin");
+}
+
+static void loadCache(void) {
+    if (cache.loaded) {
+        return;
+    }
+    cache.loaded = true;
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    getCachePath(&path);
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    if (!ffReadFileBuffer(path.chars, &content)) {
+        return;
+    }
+
+    FFResultCacheReader reader = { content.chars, content.length };
+    FF_STRBUF_AUTO_DESTROY header = ffStrbufCreate();
+    if (!ffResultCacheReadStrbuf(&reader, &header) || !ffStrbufEqualS(&header, FF_RESULT_CACHE_MAGIC) ||
+        !ffResultCacheReadStrbuf(&reader, &header) || !ffStrbufEqualS(&header, FASTFETCH_PROJECT_VERSION)) {
+        return; // Written by another fastfetch version; the format of module results may differ
+    }
+
+    while (reader.remaining > 0) {
+        FFResultCacheEntry* entry = FF_LIST_ADD(FFResultCacheEntry, cache.entries);
+        ffStrbufInit(&entry->name);
+        ffStrbufInit(&entry->validators);
+        ffStrbufInit(&entry->data);
+        entry->used = false;
+        if (!ffResultCacheReadStrbuf(&reader, &entry->name) ||
+            !ffResultCacheReadStrbuf(&reader, &entry->validators) ||
+            !ffResultCacheReadStrbuf(&reader, &entry->data) ||
+            !ffResultCacheReadData(&reader, sizeof(entry->lastUsed), &entry->lastUsed)) {
+            // Truncated file. Drop the broken entry
+            ffStrbufDestroy(&entry->name);
+            ffStrbufDestroy(&entry->validators);
+            ffStrbufDestroy(&entry->data);
+            --cache.entries.length;
+            break;
+        }
+    }
+}
+
+static void appendBootId(FFstrbuf* validators) {
+#ifdef __linux__
+    char bootId[64];
+    ssize_t len = ffReadFileData("/proc/sys/kernel/random/boot_id", sizeof(bootId), bootId);
+    if (len > 0) {
+        ffStrbufAppendNS(validators, (uint32_t) len, bootId);
+        ffStrbufTrimRightSpace(validators);
+        return;
+    }
+#endif
+
+    FFUptimeResult uptime = {};
+    if (ffDetectUptime(&uptime) == NULL) {
+        // Some platforms compute boot time from current time and uptime. Round it to absorb the jitter
+        ffStrbufAppendF(validators, "%" PRIu64, uptime.bootTime / 10000);
+    }
+}
+
+static void appendFileStat(FFstrbuf* validators, const char* path, bool inode) {
+    struct stat st;
+    if (stat(path, &st) < 0) {
+        ffStrbufAppendS(validators, "-");
+        return;
+    }
+
+    ffStrbufAppendF(validators, "%" PRIu64 ":%" PRIu64, (uint64_t) st.st_mtime, (uint64_t) st.st_size);
+    if (inode) {
+        ffStrbufAppendF(validators, ":%" PRIu64 ":%" PRIu64, (uint64_t) st.st_dev, (uint64_t) st.st_ino);
+    }
+}
+
+static void resolveKeys(const FFResultCacheKey* keys, FFstrbuf* validators) {
+    for (const FFResultCacheKey* key = keys; key->type != FF_RESULT_CACHE_KEY_NONE; ++key) {
+        switch (key->type) {
+            case FF_RESULT_CACHE_KEY_BOOT_ID:
+                ffStrbufAppendS(validators, "boot=");
+                appendBootId(validators);
+                break;
+            case FF_RESULT_CACHE_KEY_FILE_MTIME:
+                ffStrbufAppendF(validators, "mtime(%s)=", key->path);
+                appendFileStat(validators, key->path, false);
+                break;
+            case FF_RESULT_CACHE_KEY_EXE_INODE:
+                ffStrbufAppendF(validators, "inode(%s)=", key->path);
+                appendFileStat(validators, key->path, true);
+                break;
+            default:
+                break;
+        }
+        ffStrbufAppendC(validators, ';');
+    }
+}
+
+static FFResultCacheEntry* findEntry(const char* name) {
+    FF_LIST_FOR_EACH (FFResultCacheEntry, entry, cache.entries) {
+        if (ffStrbufEqualS(&entry->name, name)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool ffResultCacheGet(const char* name, const FFResultCacheKey* keys, FFResultCacheReader* reader) {
+    // Resolve the keys outside of the lock; they may hit the file system
+    FF_STRBUF_AUTO_DESTROY validators = ffStrbufCreate();
+    resolveKeys(keys, &validators);
+
+    ffThreadMutexLock(&cache.mutex);
+    loadCache();
+
+    FFResultCacheEntry* entry = findEntry(name);
+    bool found = entry && ffStrbufEqual(&entry->validators, &validators);
+    if (found) {
+        entry->used = true;
+        reader->data = entry->data.chars;
+        reader->remaining = entry->data.length;
+    }
+    ffThreadMutexUnlock(&cache.mutex);
+    return found;
+}
+
+void ffResultCacheSet(const char* name, const FFResultCacheKey* keys, const FFstrbuf* data) {
+    FF_STRBUF_AUTO_DESTROY validators = ffStrbufCreate();
+    resolveKeys(keys, &validators);
+
+    ffThreadMutexLock(&cache.mutex);
+    loadCache();
+
+    FFResultCacheEntry* entry = findEntry(name);
+    if (!entry) {
+        entry = FF_LIST_ADD(FFResultCacheEntry, cache.entries);
+        ffStrbufInitS(&entry->name, name);
+        ffStrbufInit(&entry->validators);
+        ffStrbufInit(&entry->data);
+        entry->lastUsed = 0;
+    }
+
+    ffStrbufSet(&entry->validators, &validators);
+    ffStrbufSet(&entry->data, data);
+    entry->used = true;
+    cache.dirty = true;
+    ffThreadMutexUnlock(&cache.mutex);
+}
+
+static int sortByLastUsedDesc(const FFResultCacheEntry* a, const FFResultCacheEntry* b) {
+    return a->lastUsed < b->lastUsed ? 1 : a->lastUsed > b->lastUsed ? -1 : 0;
+}
+
+void ffResultCacheSave(void) {
+    ffThreadMutexLock(&cache.mutex);
+    if (cache.dirty) {
+        uint64_t now = ffTimeGetNow();
+        FF_LIST_FOR_EACH (FFResultCacheEntry, entry, cache.entries) {
+            if (entry->used) {
+                entry->lastUsed = now;
+            }
+        }
+        ffListSort(&cache.entries, sizeof(FFResultCacheEntry), (const void*) sortByLastUsedDesc);
+
+
+        FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+        FFstrbuf header = ffStrbufCreateStatic(FF_RESULT_CACHE_MAGIC);
+        ffResultCacheWriteStrbuf(&content, &header);
+        ffStrbufSetStatic(&header, FASTFETCH_PROJECT_VERSION);
+        ffResultCacheWriteStrbuf(&content, &header);
+        for (uint32_t i = 0; i < cache.entries.length && i < FF_RESULT_CACHE_MAX_ENTRIES; ++i) {
+            FFResultCacheEntry* entry = FF_LIST_GET(FFResultCacheEntry, cache.entries, i);
+            ffResultCacheWriteStrbuf(&content, &entry->name);
+            ffResultCacheWriteStrbuf(&content, &entry->validators);
+            ffResultCacheWriteStrbuf(&content, &entry->data);
+            ffResultCacheWriteData(&content, sizeof(entry->lastUsed), &entry->lastUsed);
+        }
+
+        FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+        getCachePath(&path);
+        ffWriteFileBufferAtomic(path.chars, &content); // Private: entries may hold data only root can read (e.g. serial numbers)
+        cache.dirty = false;
+    }
+
+    FF_LIST_FOR_EACH (FFResultCacheEntry, entry, cache.entries) {
+        ffStrbufDestroy(&entry->name);
+        ffStrbufDestroy(&entry->validators);
+        ffStrbufDestroy(&entry->data);
+    }
+    ffListDestroy(&cache.entries);
+    cache.loaded = false;
+    ffThreadMutexUnlock(&cache.mutex);
+}
+
+static bool getExeVersionName(const char* kind, const char* program, const char* exePath, FFstrbuf* name) {
+    if (!instance.config.general.resultCache || !ffIsAbsolutePath(exePath)) {
+        return false;
+    }
+    ffStrbufSetF(name, "%s version:%s:%s", kind, program, exePath);
+    return true;
+}
+
+bool ffResultCacheGetExeVersion(const char* kind, const char* program, const char* exePath, FFstrbuf* version) {
+    FF_STRBUF_AUTO_DESTROY name = ffStrbufCreate();
+    if (!getExeVersionName(kind, program, exePath, &name)) {
+        return false;
+    }
+
+    const FFResultCacheKey keys[] = {
+        { .type = FF_RESULT_CACHE_KEY_EXE_INODE, .path = exePath }, // Upgraded binaries get a new inode
+        {},
+    };
+    FFResultCacheReader reader;
+    if (!ffResultCacheGet(name.chars, keys, &reader)) {
+        return false;
+    }
+
+    ffStrbufSetNS(version, reader.remaining, reader.data);
+    return true;
+}
+
+void ffResultCacheSetExeVersion(const char* kind, const char* program, const char* exePath, const FFstrbuf* version) {
+    FF_STRBUF_AUTO_DESTROY name = ffStrbufCreate();
+    if (version->length == 0 || !getExeVersionName(kind, program, exePath, &name)) {
+        return; // Detection may fail temporarily (e.g. timeout); try again next run
+    }
+
+    const FFResultCacheKey keys[] = {
+        { .type = FF_RESULT_CACHE_KEY_EXE_INODE, .path = exePath },
+        {},
+    };
+    ffResultCacheSet(name.chars, keys, version);
+}
+
+void ffResultCacheWriteData(FFstrbuf* data, uint32_t size, const void* value) {
+    ffStrbufAppendNS(data, size, value);
+}
+
+bool ffResultCacheReadData(FFResultCacheReader* reader, uint32_t size, void* value) {
+    if (reader->remaining < size) {
+        return false;
+    }
+    memcpy(value, reader->data, size);
+    reader->data += size;
+    reader->remaining -= size;
+    return true;
+}
+
+void ffResultCacheWriteStrbuf(FFstrbuf* data, const FFstrbuf* value) {
+    ffResultCacheWriteData(data, sizeof(value->length), &value->length);
+    ffResultCacheWriteData(data, value->length, value->chars);
+}
+
+bool ffResultCacheReadStrbuf(FFResultCacheReader* reader, FFstrbuf* value) {
+    uint32_t length;
+    if (!ffResultCacheReadData(reader, sizeof(length), &length) || reader->remaining < length) {
+        return false;
+    }
+    ffStrbufSetNS(value, length, reader->data);
+    reader->data += length;
+    reader->remaining -= length;
+    return true;
+}
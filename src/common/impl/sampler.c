@@ -0,0 +1,259 @@
+#include "fastfetch.h"
+#include "common/sampler.h"
+#include "common/io.h"
+#include "common/strutil.h"
+#include "common/time.h"
+#include "detection/diskio/diskio.h"
+#include "detection/netio/netio.h"
+#include "modules/diskio/diskio.h"
+#include "modules/netio/netio.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#define FF_SAMPLER_MAGIC "FFSMP1"
+
+enum {
+    FF_SAMPLER_SLOTS = 8,
+    FF_SAMPLER_MAX_CPUS = 512,
+    FF_SAMPLER_MAX_DEVICES = 64,
+};
+
+typedef struct FFSamplerDevice {
+    char key[64]; // devPath for disks, interface name for NICs
+    uint64_t counters[8];
+} FFSamplerDevice;
+
+typedef struct FFSamplerSlot {
+    uint64_t time;
+    uint32_t cpuCount;
+    uint32_t diskCount;
+    uint32_t netCount;
+    FFCpuUsageInfo cpus[FF_SAMPLER_MAX_CPUS];
+    FFSamplerDevice disks[FF_SAMPLER_MAX_DEVICES];
+    FFSamplerDevice nets[FF_SAMPLER_MAX_DEVICES];
+} FFSamplerSlot;
+
+// Single writer, lock-free readers. The writer fills slot `seq % FF_SAMPLER_SLOTS`, then increases `seq`.
+// Readers copy a slot out and check that it wasn't overwritten in the meantime
+typedef struct FFSamplerRing {
+    char magic[8];
+    uint32_t slotSize; // Detects layout changes between fastfetch versions
+    uint32_t interval;
+    uint64_t seq; // Number of finished snapshots
+    FFSamplerSlot slots[FF_SAMPLER_SLOTS];
+} FFSamplerRing;
+
+static FFSamplerSlot loaded;
+
+#ifndef _WIN32
+
+static void getRingPath(FFstrbuf* path) {
+    const char* runtimeDir = getenv("XDG_RUNTIME_DIR");
+    if (ffStrSet(runtimeDir)) {
+        ffStrbufSetS(path, runtimeDir);
+    } else {
+        ffStrbufSet(path, &instance.state.platform.cacheDir);
+    }
+    ffStrbufEnsureEndsWithC(path, '/');
+    ffStrbufAppendS(path, "fastfetch/sampler.bin");
+}
+
+static void sampleDevices(const FFlist* list, uint32_t itemSize, uint32_t keyOffset, uint32_t countersOffset, uint32_t nCounters, FFSamplerDevice* devices, uint32_t* count) {
+    *count = 0;
+    for (uint32_t i = 0; i < list->length && *count < FF_SAMPLER_MAX_DEVICES; ++i) {
+        const uint8_t* item = ffListGet(list, itemSize, i);
+        FFSamplerDevice* device = &devices[(*count)++];
+        ffStrCopy(device->key, ((const FFstrbuf*) (item + keyOffset))->chars, sizeof(device->key));
+        memcpy(device->counters, item + countersOffset, nCounters * sizeof(uint64_t));
+    }
+}
+
+static void sample(FFSamplerSlot* slot, FFDiskIOOptions* diskOptions, FFNetIOOptions* netOptions) {
+    FF_LIST_AUTO_DESTROY cpuTimes = ffListCreate();
+    if (ffGetCpuUsageInfo(&cpuTimes) == NULL && cpuTimes.length <= FF_SAMPLER_MAX_CPUS) {
+        memcpy(slot->cpus, cpuTimes.data, cpuTimes.length * sizeof(FFCpuUsageInfo));
+        slot->cpuCount = cpuTimes.length;
+    } else {
+        slot->cpuCount = 0;
+    }
+
+    FF_LIST_AUTO_DESTROY disks = ffListCreate();
+    ffDiskIOGetIoCounters(&disks, diskOptions);
+    sampleDevices(&disks, sizeof(FFDiskIOResult), offsetof(FFDiskIOResult, devPath), offsetof(FFDiskIOResult, bytesRead), 4, slot->disks, &slot->diskCount);
+    FF_LIST_FOR_EACH (FFDiskIOResult, disk, disks) {
+        ffStrbufDestroy(&disk->name);
+        ffStrbufDestroy(&disk->devPath);
+    }
+
+    FF_LIST_AUTO_DESTROY nets = ffListCreate();
+    ffNetIOGetIoCounters(&nets, netOptions);
+    sampleDevices(&nets, sizeof(FFNetIOResult), offsetof(FFNetIOResult, name), offsetof(FFNetIOResult, txBytes), 8, slot->nets, &slot->netCount);
+    FF_LIST_FOR_EACH (FFNetIOResult, net, nets) {
+        ffStrbufDestroy(&net->name);
+    }
+
+    slot->time = ffTimeGetNow();
+}
+
+void ffSamplerRun(uint32_t interval) {
+    if (interval == 0) {
+        interval = 1000;
+    }
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    getRingPath(&path);
+    {
+        uint32_t slash = ffStrbufLastIndexC(&path, '/');
+        path.chars[slash] = '\0';
+        mkdir(path.chars, S_IRWXU);
+        path.chars[slash] = '/';
+    }
+
+    // Private: without $XDG_RUNTIME_DIR the ring lives in the cache dir, which other users may be able to read
+    FF_AUTO_CLOSE_FD int fd = open(path.chars, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        fprintf(stderr, "Error: failed to open %s\n", path.chars);
+        exit(1);
+    }
+    fchmod(fd, S_IRUSR | S_IWUSR); // Rings created by older versions were world-readable
+    if (flock(fd, LOCK_EX | LOCK_NB) < 0) {
+        fprintf(stderr, "Error: another sampler is running\n");
+        exit(1);
+    }
+    if (ftruncate(fd, 0) < 0 || ftruncate(fd, sizeof(FFSamplerRing)) < 0) {
+        fprintf(stderr, "Error: failed to resize %s\n", path.chars);
+        exit(1);
+    }
+
+    FFSamplerRing* ring = mmap(NULL, sizeof(*ring), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ring == MAP_FAILED) {
+        fprintf(stderr, "Error: failed to map %s\n", path.chars);
+        exit(1);
+    }
+    ring->slotSize = sizeof(FFSamplerSlot);
+    ring->interval = interval;
+    // Publish the magic last, so that readers never see a half initialized header
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(ring->magic, FF_SAMPLER_MAGIC, sizeof(FF_SAMPLER_MAGIC));
+
+    // Default options, but sample all interfaces. Readers filter the devices themselves
+    FFDiskIOOptions diskOptions;
+    ffInitDiskIOOptions(&diskOptions);
+    FFNetIOOptions netOptions;
+    ffInitNetIOOptions(&netOptions);
+    netOptions.defaultRouteOnly = false;
+
+    for (uint64_t seq = 0;; ++seq) {
+        uint64_t start = ffTimeGetNow();
+        sample(&ring->slots[seq % FF_SAMPLER_SLOTS], &diskOptions, &netOptions);
+        __atomic_store_n(&ring->seq, seq + 1, __ATOMIC_RELEASE);
+
+        uint64_t elapsed = ffTimeGetNow() - start;
+        if (elapsed < interval) {
+            ffTimeSleep((uint32_t) (interval - elapsed));
+        }
+    }
+}
+
+uint64_t ffSamplerLoad(uint32_t minAge) {
+    loaded.time = 0;
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    getRingPath(&path);
+    FF_AUTO_CLOSE_FD int fd = open(path.chars, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size != (off_t) sizeof(FFSamplerRing)) {
+        return 0;
+    }
+
+    const FFSamplerRing* ring = mmap(NULL, sizeof(*ring), PROT_READ, MAP_SHARED, fd, 0);
+    if (ring == MAP_FAILED) {
+        return 0;
+    }
+
+    if (memcmp(ring->magic, FF_SAMPLER_MAGIC, sizeof(FF_SAMPLER_MAGIC)) != 0 || ring->slotSize != sizeof(FFSamplerSlot)) {
+        goto exit;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    uint64_t seq = __atomic_load_n(&ring->seq, __ATOMIC_ACQUIRE);
+    if (seq == 0) {
+        goto exit;
+    }
+
+    uint64_t now = ffTimeGetNow();
+    uint64_t newestTime = ring->slots[(seq - 1) % FF_SAMPLER_SLOTS].time;
+    if (newestTime > now || now - newestTime > (uint64_t) ring->interval * 3) {
+        goto exit; // The sampler has been stopped
+    }
+
+    // Slot `seq % FF_SAMPLER_SLOTS` may be being written
+    for (uint64_t n = seq; n-- > 0 && n + FF_SAMPLER_SLOTS > seq;) {
+        const FFSamplerSlot* slot = &ring->slots[n % FF_SAMPLER_SLOTS];
+        if (now - slot->time < minAge) {
+            continue;
+        }
+
+        memcpy(&loaded, slot, sizeof(loaded));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&ring->seq, __ATOMIC_RELAXED) >= n + FF_SAMPLER_SLOTS) {
+            loaded.time = 0; // Overwritten while copying
+        }
+        break;
+    }
+
+exit:
+    munmap((void*) ring, sizeof(*ring));
+    return loaded.time;
+}
+
+#else
+
+void ffSamplerRun(FF_A_UNUSED uint32_t interval) {
+    fprintf(stderr, "Error: --sampler is not supported on Windows\n");
+    exit(1);
+}
+
+uint64_t ffSamplerLoad(FF_A_UNUSED uint32_t minAge) {
+    return 0;
+}
+
+#endif
+
+const FFCpuUsageInfo* ffSamplerGetCpuTimes(uint32_t* count) {
+    if (loaded.time == 0 || loaded.cpuCount == 0) {
+        return NULL;
+    }
+    *count = loaded.cpuCount;
+    return loaded.cpus;
+}
+
+static const uint64_t* findDevice(const FFSamplerDevice* devices, uint32_t count, const char* key) {
+    if (loaded.time == 0) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        if (ffStrEquals(devices[i].key, key)) {
+            return devices[i].counters;
+        }
+    }
+    return NULL;
+}
+
+const uint64_t* ffSamplerFindDiskIO(const char* devPath) {
+    return findDevice(loaded.disks, loaded.diskCount, devPath);
+}
+
+const uint64_t* ffSamplerFindNetIO(const char* name) {
+    return findDevice(loaded.nets, loaded.netCount, name);
+}
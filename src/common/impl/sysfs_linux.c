@@ -0,0 +1,172 @@
+#include "fastfetch.h"
+#include "common/sysfs.h"
+#include "common/io.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Stay well below the default soft RLIMIT_NOFILE (1024); there may be hundreds of virtual interfaces
+enum { FF_SYSFS_MAX_CACHED_FDS = 512 };
+
+typedef struct FFSysfsAttr {
+    FFstrbuf name;
+    int fd; // -1 if the attribute doesn't exist
+} FFSysfsAttr;
+
+struct FFSysfsDevice {
+    FFstrbuf path;
+    int dfd;
+    bool stale; // The device was removed; reopen it on next lookup
+    FFlist attrs; // List of FFSysfsAttr
+};
+
+static struct {
+    FFlist devices; // List of FFSysfsDevice*, so that devices don't move
+    uint32_t openFds;
+} cache;
+
+static void closeDevice(FFSysfsDevice* device) {
+    FF_LIST_FOR_EACH (FFSysfsAttr, attr, device->attrs) {
+        if (attr->fd >= 0) {
+            close(attr->fd);
+            --cache.openFds;
+        }
+        ffStrbufDestroy(&attr->name);
+    }
+    ffListClear(&device->attrs);
+    if (device->dfd >= 0) {
+        close(device->dfd);
+        --cache.openFds;
+        device->dfd = -1;
+    }
+}
+
+static void flushCache(void) {
+    FF_LIST_FOR_EACH (FFSysfsDevice*, device, cache.devices) {
+        closeDevice(*device);
+        ffListDestroy(&(*device)->attrs);
+        ffStrbufDestroy(&(*device)->path);
+        free(*device);
+    }
+    ffListClear(&cache.devices);
+}
+
+FFSysfsDevice* ffSysfsGetDevice(const char* classPath, const char* devName) {
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS(classPath);
+    ffStrbufEnsureEndsWithC(&path, '/');
+    ffStrbufAppendS(&path, devName);
+
+    FFSysfsDevice* device = NULL;
+    FF_LIST_FOR_EACH (FFSysfsDevice*, item, cache.devices) {
+        if (ffStrbufEqual(&(*item)->path, &path)) {
+            device = *item;
+            break;
+        }
+    }
+
+    if (device && !device->stale) {
+        return device;
+    }
+
+    if (!device) {
+        if (cache.openFds >= FF_SYSFS_MAX_CACHED_FDS) {
+            flushCache(); // Rare; only on hosts with lots of devices
+        }
+
+        device = malloc(sizeof(*device));
+        ffStrbufInitMove(&device->path, &path);
+        device->dfd = -1;
+        ffListInit(&device->attrs);
+        *FF_LIST_ADD(FFSysfsDevice*, cache.devices) = device;
+    } else {
+        closeDevice(device);
+    }
+
+    device->stale = false;
+    device->dfd = open(device->path.chars, O_RDONLY | O_CLOEXEC | O_PATH | O_DIRECTORY);
+    if (device->dfd < 0) {
+        device->stale = true;
+        return NULL;
+    }
+    ++cache.openFds;
+    return device;
+}
+
+int ffSysfsGetDeviceFd(const FFSysfsDevice* device) {
+    return device->dfd;
+}
+
+// Returns the cached fd of the attribute, or -1.
+// If the cache is full, the attribute is opened without caching it, and `*uncachedFd` must be closed by the caller
+static int getAttrFd(FFSysfsDevice* device, const char* name, int* uncachedFd) {
+    *uncachedFd = -1;
+    FF_LIST_FOR_EACH (FFSysfsAttr, attr, device->attrs) {
+        if (ffStrbufEqualS(&attr->name, name)) {
+            return attr->fd;
+        }
+    }
+
+    int fd = openat(device->dfd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0 && errno != ENOENT) {
+        return -1; // Don't remember other errors; they may be temporary
+    }
+
+    if (fd >= 0 && cache.openFds >= FF_SYSFS_MAX_CACHED_FDS) {
+        *uncachedFd = fd;
+        return -1;
+    }
+
+    FFSysfsAttr* attr = FF_LIST_ADD(FFSysfsAttr, device->attrs);
+    ffStrbufInitS(&attr->name, name);
+    attr->fd = fd;
+    if (fd >= 0) {
+        ++cache.openFds;
+    }
+    return fd;
+}
+
+static bool readAttr(FFSysfsDevice* device, const char* name, char* buf, size_t size, ssize_t* length) {
+    FF_AUTO_CLOSE_FD int uncachedFd = -1;
+    int fd = getAttrFd(device, name, &uncachedFd);
+    if (fd < 0) {
+        fd = uncachedFd;
+    }
+    if (fd < 0) {
+        return false;
+    }
+
+    *length = pread(fd, buf, size, 0);
+    if (*length < 0) {
+        if (errno == ENODEV || errno == ENOENT) {
+            device->stale = true;
+        }
+        return false;
+    }
+    return *length > 0;
+}
+
+bool ffSysfsReadAttr(FFSysfsDevice* device, const char* name, FFstrbuf* buffer) {
+    // sysfs attributes are at most one page
+    ffStrbufClear(buffer);
+    ffStrbufEnsureFree(buffer, 4096);
+
+    ssize_t length;
+    if (!readAttr(device, name, buffer->chars, 4096, &length)) {
+        return false;
+    }
+    buffer->length = (uint32_t) length;
+    buffer->chars[length] = '\0';
+    return true;
+}
+
+void ffSysfsReadUInts(FFSysfsDevice* device, uint32_t count, const char* const names[], uint64_t values[]) {
+    for (uint32_t i = 0; i < count; ++i) {
+        char buf[32];
+        ssize_t length;
+        if (readAttr(device, names[i], buf, sizeof(buf) - 1, &length)) {
+            buf[length] = '\0';
+            values[i] = strtoull(buf, NULL, 10);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#include "fastfetch.h"
+#include "common/trace.h"
+#include "common/jsonconfig.h"
+#include "common/strutil.h"
+#include "common/thread.h"
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+typedef struct FFTraceEvent {
+    const char* category;
+    FFstrbuf name;
+    double start;
+    double duration;
+    int64_t bytes;
+    uint64_t tid;
+} FFTraceEvent;
+
+bool ffTraceEnabled;
+
+static struct {
+    FFstrbuf path;
+    double origin;
+    FFlist events; // List of FFTraceEvent
+    FFThreadMutex mutex;
+} trace = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+};
+
+static uint64_t getThreadId(void) {
+#if !FF_HAVE_THREADS
+    return 0;
+#elif _WIN32
+    return GetCurrentThreadId();
+#else
+    return (uint64_t) (uintptr_t) pthread_self();
+#endif
+}
+
+void ffTraceStart(const char* path) {
+    ffStrbufInitS(&trace.path, path);
+    ffListInit(&trace.events);
+    trace.origin = ffTimeGetTick();
+    ffTraceEnabled = true;
+}
+
+void ffTraceSpanRecord(const FFTraceSpan* span) {
+    double end = ffTimeGetTick();
+    uint64_t tid = getThreadId();
+
+    ffThreadMutexLock(&trace.mutex);
+    FFTraceEvent* event = FF_LIST_ADD(FFTraceEvent, trace.events);
+    event->category = span->category;
+    ffStrbufInitS(&event->name, span->name ? span->name : "");
+    event->start = span->start;
+    event->duration = end - span->start;
+    event->bytes = span->bytes;
+    event->tid = tid;
+    ffThreadMutexUnlock(&trace.mutex);
+}
+
+typedef struct FFTraceSummary {
+    const char* category;
+    uint32_t count;
+    double duration;
+    uint64_t bytes;
+} FFTraceSummary;
+
+void ffTraceSave(void) {
+    if (!ffTraceEnabled) {
+        return;
+    }
+    ffTraceEnabled = false;
+
+    yyjson_mut_doc* doc = yyjson_mut_doc_new(NULL);
+    yyjson_mut_val* root = yyjson_mut_obj(doc);
+    yyjson_mut_doc_set_root(doc, root);
+    yyjson_mut_obj_add_str(doc, root, "displayTimeUnit", "ms");
+    yyjson_mut_val* events = yyjson_mut_obj_add_arr(doc, root, "traceEvents");
+
+    FFTraceSummary summaries[16] = {};
+    uint32_t summaryCount = 0;
+
+    FF_LIST_FOR_EACH (FFTraceEvent, event, trace.events) {
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, events);
+        yyjson_mut_obj_add_strbuf(doc, obj, "name", &event->name);
+        yyjson_mut_obj_add_str(doc, obj, "cat", event->category);
+        yyjson_mut_obj_add_str(doc, obj, "ph", "X");
+        yyjson_mut_obj_add_real(doc, obj, "ts", (event->start - trace.origin) * 1000);
+        yyjson_mut_obj_add_real(doc, obj, "dur", event->duration * 1000);
+        yyjson_mut_obj_add_uint(doc, obj, "pid", instance.state.platform.pid);
+        yyjson_mut_obj_add_uint(doc, obj, "tid", event->tid);
+        if (event->bytes >= 0) {
+            yyjson_mut_val* args = yyjson_mut_obj_add_obj(doc, obj, "args");
+            yyjson_mut_obj_add_int(doc, args, "bytes", event->bytes);
+        }
+
+        FFTraceSummary* summary = NULL;
+        for (uint32_t i = 0; i < summaryCount; ++i) {
+            if (ffStrEquals(summaries[i].category, event->category)) {
+                summary = &summaries[i];
+                break;
+            }
+        }
+        if (!summary && summaryCount < sizeof(summaries) / sizeof(summaries[0])) {
+            summary = &summaries[summaryCount++];
+            summary->category = event->category;
+        }
+        if (summary) {
+            ++summary->count;
+            summary->duration += event->duration;
+            if (event->bytes > 0) {
+                summary->bytes += (uint64_t) event->bytes;
+            }
+        }
+
+        ffStrbufDestroy(&event->name);
+    }
+    ffListDestroy(&trace.events);
+
+    // Per category totals
+    yyjson_mut_val* otherData = yyjson_mut_obj_add_obj(doc, root, "otherData");
+    for (uint32_t i = 0; i < summaryCount; ++i) {
+        yyjson_mut_val* obj = yyjson_mut_obj_add_obj(doc, otherData, summaries[i].category);
+        yyjson_mut_obj_add_uint(doc, obj, "count", summaries[i].count);
+        yyjson_mut_obj_add_real(doc, obj, "ms", summaries[i].duration);
+        yyjson_mut_obj_add_uint(doc, obj, "bytes", summaries[i].bytes);
+    }
+
+    if (!yyjson_mut_write_file(trace.path.chars, doc, YYJSON_WRITE_INF_AND_NAN_AS_NULL, NULL, NULL)) {
+        fprintf(stderr, "Error: failed to write trace file `%s`\n", trace.path.chars);
+    }
+    yyjson_mut_doc_free(doc);
+    ffStrbufDestroy(&trace.path);
+}
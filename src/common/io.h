@@ -2,6 +2,7 @@
 
 #include "common/FFstrbuf.h"
 #include "common/FFlist.h"
+#include "common/trace.h"
 
 #ifdef _WIN32
     #include <fileapi.h>
@@ -91,6 +92,14 @@ FF_A_NONNULL(1, 2) static inline bool ffWriteFileBuffer(const char* fileName, co
     return ffWriteFileData(fileName, buffer->length, buffer->chars);
 }
 
+// Writes a temporary file and renames it over `fileName`, so that other processes reading or mapping the file
+// never see it half written or truncated. On Unix, the file is readable by the current user only
+FF_A_NONNULL(1, 3) bool ffWriteFileDataAtomic(const char* fileName, size_t dataSize, const void* data);
+
+FF_A_NONNULL(1, 2) static inline bool ffWriteFileBufferAtomic(const char* fileName, const FFstrbuf* buffer) {
+    return ffWriteFileDataAtomic(fileName, buffer->length, buffer->chars);
+}
+
 FF_A_NONNULL(3) static inline ssize_t ffReadFDData(FFNativeFD fd, size_t dataSize, void* data) {
 #ifndef _WIN32
     return read(fd, data, dataSize);
@@ -107,6 +116,7 @@ FF_A_NONNULL(3) static inline ssize_t ffReadFDData(FFNativeFD fd, size_t dataSiz
 FF_A_NONNULL(2) bool ffAppendFDBuffer(FFNativeFD fd, FFstrbuf* buffer);
 
 FF_A_NONNULL(1, 3) static inline ssize_t ffReadFileData(const char* fileName, size_t dataSize, void* data) {
+    FF_TRACE_SPAN(span, "file", fileName);
     FFNativeFD FF_AUTO_CLOSE_FD fd =
 #ifndef _WIN32
         open(fileName, O_RDONLY | O_CLOEXEC);
@@ -118,19 +128,21 @@ FF_A_NONNULL(1, 3) static inline ssize_t ffReadFileData(const char* fileName, si
         return -1;
     }
 
-    return ffReadFDData(fd, dataSize, data);
+    return span.bytes = ffReadFDData(fd, dataSize, data);
 }
 
 FF_A_NONNULL(2, 4) static inline ssize_t ffReadFileDataRelative(FFNativeFD dfd, const char* fileName, size_t dataSize, void* data) {
+    FF_TRACE_SPAN(span, "file", fileName);
     FFNativeFD FF_AUTO_CLOSE_FD fd = openat(dfd, fileName, O_RDONLY | O_CLOEXEC);
     if (!ffIsValidNativeFD(fd)) {
         return -1;
     }
 
-    return ffReadFDData(fd, dataSize, data);
+    return span.bytes = ffReadFDData(fd, dataSize, data);
 }
 
 FF_A_NONNULL(1, 2) static inline bool ffAppendFileBuffer(const char* fileName, FFstrbuf* buffer) {
+    FF_TRACE_SPAN(span, "file", fileName);
     FFNativeFD FF_AUTO_CLOSE_FD fd =
 #ifndef _WIN32
         open(fileName, O_RDONLY | O_CLOEXEC);
@@ -142,16 +154,23 @@ FF_A_NONNULL(1, 2) static inline bool ffAppendFileBuffer(const char* fileName, F
         return false;
     }
 
-    return ffAppendFDBuffer(fd, buffer);
+    uint32_t oldLength = buffer->length;
+    bool result = ffAppendFDBuffer(fd, buffer);
+    span.bytes = buffer->length - oldLength;
+    return result;
 }
 
 FF_A_NONNULL(2, 3) static inline bool ffAppendFileBufferRelative(FFNativeFD dfd, const char* fileName, FFstrbuf* buffer) {
+    FF_TRACE_SPAN(span, "file", fileName);
     FFNativeFD FF_AUTO_CLOSE_FD fd = openat(dfd, fileName, O_RDONLY | O_CLOEXEC);
     if (!ffIsValidNativeFD(fd)) {
         return false;
     }
 
-    return ffAppendFDBuffer(fd, buffer);
+    uint32_t oldLength = buffer->length;
+    bool result = ffAppendFDBuffer(fd, buffer);
+    span.bytes = buffer->length - oldLength;
+    return result;
 }
 
 FF_A_NONNULL(2) static inline bool ffReadFDBuffer(FFNativeFD fd, FFstrbuf* buffer) {
@@ -21,13 +21,6 @@ int dlclose(void* handle);
         #define FF_LIBRARY_EXTENSION ".so"
     #endif
 
-static inline void ffLibraryUnload(void** handle) {
-    assert(handle);
-    if (*handle) {
-        dlclose(*handle);
-    }
-}
-
     #if __cplusplus
         #define __auto_type auto
     #endif
@@ -35,9 +28,9 @@ static inline void ffLibraryUnload(void** handle) {
     #define FF_LIBRARY_SYMBOL(symbolName) \
         __typeof__(&symbolName) ff##symbolName;
 
-    #define FF_LIBRARY_LOAD(libraryObjectName, returnValue, ...)                                  \
-        void* FF_A_CLEANUP(ffLibraryUnload) libraryObjectName = ffLibraryLoad(__VA_ARGS__, NULL); \
-        if (libraryObjectName == NULL)                                                            \
+    #define FF_LIBRARY_LOAD(libraryObjectName, returnValue, ...)       \
+        void* libraryObjectName = ffLibraryLoad(__VA_ARGS__, NULL); \
+        if (libraryObjectName == NULL)                                 \
             return returnValue;
 
     #define FF_LIBRARY_LOAD_MESSAGE(libraryObjectName, libraryFileName, maxVersion, ...) \
@@ -66,6 +59,10 @@ static inline void ffLibraryUnload(void** handle) {
     #define FF_LIBRARY_LOAD_SYMBOL_PTR(library, varName, symbolName, returnValue) \
         FF_LIBRARY_LOAD_SYMBOL_ADDRESS(library, (varName)->ff##symbolName, symbolName, returnValue);
 
+// Load the first library found of (path, maxVersion) pairs, terminated by NULL.
+// `maxVersion` >= 0 also probes versioned names `path.maxVersion` down to `path.0`.
+// Results (including failures) are shared process-wide, and the resolved names are remembered across runs.
+// The returned handle is owned by the registry and must not be dlclose'd
 void* ffLibraryLoad(const char* path, int maxVersion, ...);
 
 #else
@@ -30,7 +30,9 @@ extern struct FFLuaData {
     #if !FF_DISABLE_DLOPEN
     FF_LIBRARY_SYMBOL(luaL_checkany)
     FF_LIBRARY_SYMBOL(luaL_loadbufferx)
+    FF_LIBRARY_SYMBOL(luaL_ref)
     FF_LIBRARY_SYMBOL(luaL_tolstring)
+    FF_LIBRARY_SYMBOL(luaL_unref)
     FF_LIBRARY_SYMBOL(lua_callk)
     FF_LIBRARY_SYMBOL(lua_createtable)
     FF_LIBRARY_SYMBOL(lua_error)
@@ -60,6 +62,7 @@ extern struct FFLuaData {
 
     lua_State* L;
     bool inited;
+    FFlist formatScripts; // List of FFScriptCacheEntry, compiled `lua:` format strings. See format.c
 } luaData;
 
     #if !FF_DISABLE_DLOPEN
@@ -71,6 +74,14 @@ FF_A_ALWAYS_INLINE int(luaL_loadbufferx)(lua_State* L, const char* buff, size_t
     return luaData.ffluaL_loadbufferx(L, buff, sz, name, mode);
 }
 
+FF_A_ALWAYS_INLINE int(luaL_ref)(lua_State* L, int t) {
+    return luaData.ffluaL_ref(L, t);
+}
+
+FF_A_ALWAYS_INLINE void(luaL_unref)(lua_State* L, int t, int ref) {
+    luaData.ffluaL_unref(L, t, ref);
+}
+
 FF_A_ALWAYS_INLINE const char*(lua_tolstring) (lua_State * L, int idx, size_t* len) {
     return luaData.fflua_tolstring(L, idx, len);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <assert.h>
 #include "common/attributes.h"
@@ -38,3 +39,14 @@ static inline size_t ffMallocUsableSize(const void* ptr) {
     return 0; // Not supported
 #endif
 }
+
+// Number of heap allocations (malloc / realloc) made by FFstrbuf and FFlist, in all threads. Reported by `--stat`
+extern uint32_t ffAllocCount;
+
+static inline void ffAllocCountAdd(void) {
+    __atomic_fetch_add(&ffAllocCount, 1, __ATOMIC_RELAXED);
+}
+
+static inline uint32_t ffAllocCountGet(void) {
+    return __atomic_load_n(&ffAllocCount, __ATOMIC_RELAXED);
+}
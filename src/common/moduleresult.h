@@ -0,0 +1,19 @@
+#pragma once
+
+#include "common/option.h"
+
+// Helpers for modules implementing `FFModuleBaseInfo::detectResult`
+
+// Detect and render the module without sharing the result. Used by `ffPrint*` functions
+bool ffModuleResultPrint(const FFModuleBaseInfo* baseInfo, void* options);
+bool ffModuleResultGenerateJson(const FFModuleBaseInfo* baseInfo, void* options, struct yyjson_mut_doc* doc, struct yyjson_mut_val* module);
+
+// Generate the key identifying module instances that can share a detection result. `module` can be NULL
+void ffModuleResultGenerateKey(struct yyjson_val* module, FFstrbuf* key);
+// Detect the module, or reuse the result of a previous instance with the same key.
+// `*result` is valid until `ffModuleResultClear` is called
+const char* ffModuleResultDetect(const FFModuleBaseInfo* baseInfo, void* options, const char* key, void** result);
+// Whether a result of the previous pass is kept for the current one. Lets `ffPrepare*` functions skip work that wouldn't be used
+bool ffModuleResultIsKept(const FFModuleBaseInfo* baseInfo);
+// Release the results. In `--dynamic-interval` mode, results still valid in the next tick are kept (see `FFModuleBaseInfo::refreshInterval`)
+void ffModuleResultClear(void);
@@ -5,6 +5,8 @@
 struct yyjson_val;
 struct yyjson_mut_doc;
 struct yyjson_mut_val;
+struct FFResultCacheKey;
+struct FFResultCacheReader;
 
 typedef struct FFModuleFormatArg {
     const char* desc;
@@ -18,6 +20,8 @@ typedef struct FFModuleFormatArgList {
 
 #define FF_FORMAT_ARG_LIST(list) { .args = list, .count = sizeof(list) / sizeof(FFModuleFormatArg) }
 
+#define FF_MODULE_REFRESH_NEVER UINT32_MAX // See `FFModuleBaseInfo::refreshInterval`
+
 // Must be the first field of FFModuleOptions
 typedef struct FFModuleBaseInfo {
     const char* name;
@@ -34,6 +38,26 @@ typedef struct FFModuleBaseInfo {
     bool (*generateJsonResult)(void* options, struct yyjson_mut_doc* doc, struct yyjson_mut_val* module); // true on success
     void (*generateJsonConfig)(void* options, struct yyjson_mut_doc* doc, struct yyjson_mut_val* obj);
     FFModuleFormatArgList formatArgs;
+
+    // Optional. Split `printModule` / `generateJsonResult` into a detection phase and rendering phases.
+    // When set, the detection result (and error) is shared by all instances of the module with identical detection options.
+    // Renderers must not modify `result`
+    uint32_t resultSize;                                                                                                               // <= FF_RESULT_MAX_SIZE
+    const char* (*detectResult)(void* options, void* result);                                                                          // NULL on success; `result` is zero-initialized
+    void (*destroyResult)(void* result);                                                                                               // Called even if `detectResult` failed
+    bool (*printResult)(void* options, const char* error, void* result);                                                               // true on success
+    bool (*generateJsonResultFrom)(void* options, const char* error, void* result, struct yyjson_mut_doc* doc, struct yyjson_mut_val* module); // true on success
+
+    // Optional. Persist successful detection results across runs (see `common/resultcache.h`).
+    // Only for modules whose detection doesn't depend on module options
+    const struct FFResultCacheKey* cacheKeys;                                                                                          // Terminated by `FF_RESULT_CACHE_KEY_NONE`
+    void (*serializeResult)(void* result, FFstrbuf* data);
+    bool (*deserializeResult)(void* result, struct FFResultCacheReader* reader);                                                       // `result` is zero-initialized; `destroyResult` is called on failure
+
+    // Optional. How long a shared detection result is reused in `--dynamic-interval` mode, in ms.
+    // 0 (default) re-detects the module every tick; `FF_MODULE_REFRESH_NEVER` detects it only once
+    uint32_t refreshInterval;
+    uint32_t (*getRefreshInterval)(void* options); // Optional. Overrides `refreshInterval`, e.g. when options enable fast changing values
 } FFModuleBaseInfo;
 
 typedef enum FF_A_PACKED FFModuleKeyType {
@@ -94,3 +118,4 @@ static inline void ffOptionDestroyModuleArg(FFModuleArgs* args) {
 }
 
 enum { FF_OPTION_MAX_SIZE = 1 << 8 }; // Maximum size of a single option value, used for static allocation
+enum { FF_RESULT_MAX_SIZE = 1 << 10 }; // Maximum size of a single detection result, used for static allocation
@@ -16,9 +16,19 @@ typedef struct FFProcessHandle {
 #endif
 } FFProcessHandle;
 
+// Thread-safe. Children get a private copy of the environment with `LANG=C.UTF-8`
 const char* ffProcessSpawn(char* const argv[], bool useStdErr, FFProcessHandle* outHandle);
 const char* ffProcessReadOutput(FFProcessHandle* handle, FFstrbuf* buffer); // Destroys handle internally
 
+// A process spawned by `ffProcessSpawnAsync`. Its output is collected while waiting for any future,
+// so that slow commands spawned up front run in parallel instead of adding up.
+// Each future times out `--processing-timeout` ms after it was spawned.
+// Not thread-safe; must be used in main thread only
+typedef struct FFProcessFuture FFProcessFuture;
+
+const char* ffProcessSpawnAsync(char* const argv[], bool useStdErr, FFProcessFuture** outFuture);
+const char* ffProcessFutureGet(FFProcessFuture* future, FFstrbuf* buffer); // Appends the output. Frees future
+
 static inline const char* ffProcessAppendStdOut(FFstrbuf* buffer, char* const argv[]) {
     FFProcessHandle handle;
     const char* error = ffProcessSpawn(argv, false, &handle);
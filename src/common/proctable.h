@@ -0,0 +1,31 @@
+#pragma once
+
+#include "fastfetch.h"
+
+#include <sys/types.h>
+
+// Snapshot of all processes, taken in a single pass over `/proc` and shared by all modules that scan processes.
+// Linux and GNU Hurd only
+typedef struct FFProcTableEntry {
+    pid_t pid;
+    pid_t ppid;
+    uid_t uid; // Effective uid (owner of `/proc/pid/stat`)
+    int32_t tty; // `tty_nr` field of `/proc/pid/stat`
+    uint32_t threads;
+    char comm[32]; // Process name as in `/proc/pid/stat`. Empty if it doesn't fit
+} FFProcTableEntry;
+
+typedef struct FFProcTable {
+    FFlist entries; // List of FFProcTableEntry, sorted by pid
+    uint32_t threads; // Sum of `threads` of all entries
+} FFProcTable;
+
+// Build the snapshot on first call. NULL if `/proc` can't be read. Thread-safe
+const FFProcTable* ffProcTableGet(void);
+
+// Discard the snapshot, so that the next `ffProcTableGet` takes a new one.
+// Called after each print pass; pointers into the table must not be used afterwards
+void ffProcTableClear(void);
+
+// Look up a process in the snapshot, without building it. NULL if not built yet or not found
+const FFProcTableEntry* ffProcTableFind(pid_t pid);
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "fastfetch.h"
+
+// Persistent cache of module detection results, stored in `$cacheDir/fastfetch/results.bin`.
+// Each entry is validated by a list of invalidation keys, which are resolved at lookup time.
+// Thread-safe. A reader stays valid until its entry is set again or the cache is saved
+
+typedef enum FF_A_PACKED FFResultCacheKeyType {
+    FF_RESULT_CACHE_KEY_NONE,       // Terminator
+    FF_RESULT_CACHE_KEY_BOOT_ID,    // Invalidated after reboot
+    FF_RESULT_CACHE_KEY_FILE_MTIME, // Invalidated when `path` is modified, created or removed
+    FF_RESULT_CACHE_KEY_EXE_INODE,  // Invalidated when the executable `path` is replaced (e.g. upgraded)
+} FFResultCacheKeyType;
+
+typedef struct FFResultCacheKey {
+    FFResultCacheKeyType type;
+    const char* path;
+} FFResultCacheKey;
+
+typedef struct FFResultCacheReader {
+    const char* data;
+    uint32_t remaining;
+} FFResultCacheReader;
+
+// Returns false if the entry is missing or outdated
+bool ffResultCacheGet(const char* name, const FFResultCacheKey* keys, FFResultCacheReader* reader);
+void ffResultCacheSet(const char* name, const FFResultCacheKey* keys, const FFstrbuf* data);
+// Write the cache file if modified
+void ffResultCacheSave(void);
+
+// Version of `program` run from the executable `exePath`, as detected by module `kind` in a previous run.
+// `program` keeps interpreters (e.g. python) hosting several programs apart.
+// Invalidated when the executable is replaced; `exePath` must be absolute
+bool ffResultCacheGetExeVersion(const char* kind, const char* program, const char* exePath, FFstrbuf* version);
+void ffResultCacheSetExeVersion(const char* kind, const char* program, const char* exePath, const FFstrbuf* version);
+
+void ffResultCacheWriteData(FFstrbuf* data, uint32_t size, const void* value);
+bool ffResultCacheReadData(FFResultCacheReader* reader, uint32_t size, void* value);
+void ffResultCacheWriteStrbuf(FFstrbuf* data, const FFstrbuf* value);
+bool ffResultCacheReadStrbuf(FFResultCacheReader* reader, FFstrbuf* value);
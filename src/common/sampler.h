@@ -0,0 +1,21 @@
+#pragma once
+
+#include "fastfetch.h"
+#include "detection/cpuusage/cpuusage.h"
+
+// Background sampler for CPUUsage, DiskIO and NetIO (`fastfetch --sampler`).
+// The sampler process keeps a ring of counter snapshots in a shared file (`$XDG_RUNTIME_DIR/fastfetch/sampler.bin`).
+// Later fastfetch runs use an old enough snapshot as their first sample, instead of sleeping `waitTime` ms.
+// Not thread-safe; must be used in main thread only
+
+// Run the sampler until killed. Takes a snapshot every `interval` ms
+void ffSamplerRun(uint32_t interval);
+
+// Load the newest snapshot taken at least `minAge` ms ago.
+// Returns its timestamp (`ffTimeGetNow()` based), or 0 if the sampler isn't running
+uint64_t ffSamplerLoad(uint32_t minAge);
+
+// Accessors of the snapshot loaded by `ffSamplerLoad`. NULL if not found
+const FFCpuUsageInfo* ffSamplerGetCpuTimes(uint32_t* count);
+const uint64_t* ffSamplerFindDiskIO(const char* devPath); // bytesRead, readCount, bytesWritten, writeCount
+const uint64_t* ffSamplerFindNetIO(const char* name);     // txBytes, rxBytes, txPackets, rxPackets, rxErrors, txErrors, rxDrops, txDrops
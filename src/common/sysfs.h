@@ -0,0 +1,23 @@
+#pragma once
+
+#include "fastfetch.h"
+
+// Cached reader of sysfs attributes, e.g. `/sys/class/net/eth0/statistics/rx_bytes`.
+// Device directories and attribute files are opened once and kept open across reads.
+// A later read of the same attribute is a single `pread` at offset 0, which makes sysfs regenerate the value.
+// Intended for counters polled repeatedly (`--dynamic-interval`, `--sampler`, two samples of NetIO / DiskIO).
+// Linux only. Not thread-safe; must be used in main thread only
+typedef struct FFSysfsDevice FFSysfsDevice;
+
+// Open the device directory `classPath/devName`, or reuse the cached one. NULL if it doesn't exist.
+// The returned device is valid until the next call
+FFSysfsDevice* ffSysfsGetDevice(const char* classPath, const char* devName);
+
+// The device directory fd, for lookups that don't need caching (e.g. `faccessat`)
+int ffSysfsGetDeviceFd(const FFSysfsDevice* device);
+
+// Read attribute `name` (relative to the device directory) into `buffer`. False if it doesn't exist or is empty
+bool ffSysfsReadAttr(FFSysfsDevice* device, const char* name, FFstrbuf* buffer);
+
+// Read the unsigned integer attributes `names[i]` into `values[i]`. Unreadable attributes are left unchanged
+void ffSysfsReadUInts(FFSysfsDevice* device, uint32_t count, const char* const names[], uint64_t values[]);
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "common/attributes.h"
+#include "common/time.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Built-in profiler enabled by `--stat-trace <file>`.
+// Records spans of platform init, config parsing, logo printing, modules, dlopen, subprocesses and file reads,
+// and writes them as a Chrome trace-event JSON file at exit (load it in `chrome://tracing` or https://ui.perfetto.dev)
+
+typedef struct FFTraceSpan {
+    double start; // 0 if tracing is disabled
+    const char* category;
+    const char* name;
+    int64_t bytes; // Bytes read; -1 if not applicable
+} FFTraceSpan;
+
+extern bool ffTraceEnabled;
+
+// Must be called before `ffInitInstance` to trace platform initialization
+void ffTraceStart(const char* path);
+// Write the trace file
+void ffTraceSave(void);
+
+void ffTraceSpanRecord(const FFTraceSpan* span);
+
+static inline FFTraceSpan ffTraceSpanBegin(const char* category, const char* name) {
+    return (FFTraceSpan) {
+        .start = __builtin_expect(ffTraceEnabled, false) ? ffTimeGetTick() : 0,
+        .category = category,
+        .name = name,
+        .bytes = -1,
+    };
+}
+
+static inline void ffTraceSpanEnd(FFTraceSpan* span) {
+    if (__builtin_expect(span->start != 0, false)) {
+        ffTraceSpanRecord(span);
+        span->start = 0;
+    }
+}
+
+// The span ends when `var` goes out of scope. `name` must be valid until then
+#define FF_TRACE_SPAN(var, category, name) FFTraceSpan FF_A_CLEANUP(ffTraceSpanEnd) var = ffTraceSpanBegin(category, name)
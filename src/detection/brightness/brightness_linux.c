@@ -111,8 +111,6 @@ static const char* detectWithDdcci(FF_A_UNUSED FFBrightnessOptions* options, FFl
         if (ffddca_set_default_sleep_multiplier) {
             ffddca_set_default_sleep_multiplier(options->ddcciSleep / 40.0);
         }
-
-        libddcutil = NULL; // Don't dlclose libddcutil. See https://github.com/rockowitz/ddcutil/issues/330
     }
     #else
         #if DDCUTIL_VMAJOR >= 2
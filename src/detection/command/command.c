@@ -3,26 +3,27 @@
 #include "common/FFstrbuf.h"
 
 typedef struct FFCommandResultBundle {
-    FFProcessHandle handle;
+    FFProcessFuture* future;
     const char* error;
 } FFCommandResultBundle;
 
 // FIFO, non-thread-safe list of running commands
 static FFlist commandQueue;
 
-static const char* spawnProcess(FFCommandOptions* options, FFProcessHandle* handle) {
+static const char* spawnProcess(FFCommandOptions* options, FFProcessHandle* handle, FFProcessFuture** future) {
     if (options->text.length == 0) {
         return "No command text specified";
     }
 
-    return ffProcessSpawn(options->param.length ? (char* const[]) {
-                                                      options->shell.chars,
-                                                      options->param.chars,
-                                                      options->text.chars,
-                                                      NULL }
-                                                : (char* const[]) { options->shell.chars, options->text.chars, NULL },
-        options->useStdErr,
-        handle);
+    char* const* argv = options->param.length ? (char* const[]) {
+                                                    options->shell.chars,
+                                                    options->param.chars,
+                                                    options->text.chars,
+                                                    NULL }
+                                              : (char* const[]) { options->shell.chars, options->text.chars, NULL };
+    return future
+        ? ffProcessSpawnAsync(argv, options->useStdErr, future)
+        : ffProcessSpawn(argv, options->useStdErr, handle);
 }
 
 bool ffPrepareCommand(FFCommandOptions* options) {
@@ -30,8 +31,9 @@ bool ffPrepareCommand(FFCommandOptions* options) {
         return false;
     }
 
+    // The outputs of all prepared commands are read together, so that they run in parallel
     FFCommandResultBundle* bundle = FF_LIST_ADD(FFCommandResultBundle, commandQueue);
-    bundle->error = spawnProcess(options, &bundle->handle);
+    bundle->error = spawnProcess(options, NULL, &bundle->future);
 
     return true;
 }
@@ -39,20 +41,21 @@ bool ffPrepareCommand(FFCommandOptions* options) {
 const char* ffDetectCommand(FFCommandOptions* options, FFstrbuf* result) {
     FFCommandResultBundle bundle = {};
     if (!options->parallel) {
-        bundle.error = spawnProcess(options, &bundle.handle);
+        FFProcessHandle handle;
+        bundle.error = spawnProcess(options, &handle, NULL);
+        if (!bundle.error) {
+            bundle.error = ffProcessReadOutput(&handle, result);
+        }
     } else if (!FF_LIST_SHIFT(commandQueue, &bundle)) {
         return "[BUG] command queue is empty";
+    } else if (!bundle.error) {
+        bundle.error = ffProcessFutureGet(bundle.future, result);
     }
 
     if (bundle.error) {
         return bundle.error;
     }
 
-    bundle.error = ffProcessReadOutput(&bundle.handle, result);
-    if (bundle.error) {
-        return bundle.error;
-    }
-
     ffStrbufTrimRightSpace(result);
     return NULL;
 }
@@ -1,5 +1,6 @@
 #include "fastfetch.h"
 #include "detection/cpuusage/cpuusage.h"
+#include "common/sampler.h"
 #include "common/time.h"
 
 #include <stdint.h>
@@ -7,6 +8,23 @@
 static FFlist cpuTimes1;
 static uint64_t startTime;
 
+// Replace the first sample with an older one taken by `fastfetch --sampler`, so that we don't need to wait
+static bool loadFromSampler(uint32_t waitTime) {
+    uint64_t sampleTime = ffSamplerLoad(waitTime);
+    if (sampleTime == 0) {
+        return false;
+    }
+
+    uint32_t count;
+    const FFCpuUsageInfo* cpuTimes = ffSamplerGetCpuTimes(&count);
+    if (!cpuTimes || count != cpuTimes1.length) {
+        return false;
+    }
+    memcpy(cpuTimes1.data, cpuTimes, sizeof(*cpuTimes) * count);
+    startTime = sampleTime;
+    return true;
+}
+
 void ffPrepareCPUUsage(void) {
     if (startTime != 0) {
         return; // Already prepared
@@ -25,12 +43,12 @@ const char* ffGetCpuUsageResult(FFCPUUsageOptions* options, FFlist* result) {
         if (error) {
             return error;
         }
-        ffTimeSleep(options->waitTime);
-    } else {
-        uint64_t elapsedTime = ffTimeGetNow() - startTime;
-        if (elapsedTime < options->waitTime) {
-            ffTimeSleep(options->waitTime - (uint32_t) elapsedTime);
-        }
+        startTime = ffTimeGetNow();
+    }
+
+    uint64_t elapsedTime = ffTimeGetNow() - startTime;
+    if (elapsedTime < options->waitTime && !loadFromSampler(options->waitTime)) {
+        ffTimeSleep(options->waitTime - (uint32_t) elapsedTime);
     }
 
     if (cpuTimes1.length == 0) {
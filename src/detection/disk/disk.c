@@ -20,6 +20,9 @@ const char* ffDetectDisks(FFDiskOptions* options, FFlist* disks) {
     //  so the check must be done in reverse order
     ffListSort(disks, sizeof(FFDisk), (void*) compareDisks);
     FF_LIST_FOR_EACH (FFDisk, disk, *disks) {
+        if (disk->type & FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT) {
+            continue;
+        }
         if (disk->bytesTotal == 0) {
             disk->type |= FF_DISK_VOLUME_TYPE_UNKNOWN_BIT;
         } else {
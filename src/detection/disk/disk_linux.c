@@ -2,10 +2,13 @@
 
 #include "common/io.h"
 #include "common/strutil.h"
+#include "common/thread.h"
 
 #include <limits.h>
 #include <ctype.h>
 #include <dirent.h>
+#include <errno.h>
+#include <time.h>
 #include <mntent.h>
 #include <sys/stat.h>
 #include <sys/statvfs.h>
@@ -162,51 +165,73 @@ static void detectName(FFDisk* disk) {
 
 #ifdef __ANDROID__
 
-static void detectType(FF_A_UNUSED const FFlist* disks, FFDisk* currentDisk, FF_A_UNUSED struct mntent* device) {
-    if (ffStrbufEqualS(&currentDisk->mountpoint, "/") || ffStrbufEqualS(&currentDisk->mountpoint, "/storage/emulated")) {
-        currentDisk->type = FF_DISK_VOLUME_TYPE_REGULAR_BIT;
-    } else if (ffStrbufStartsWithS(&currentDisk->mountpoint, "/mnt/media_rw/")) {
-        currentDisk->type = FF_DISK_VOLUME_TYPE_EXTERNAL_BIT;
-    } else {
-        currentDisk->type = FF_DISK_VOLUME_TYPE_HIDDEN_BIT;
+static void detectMountFlags(FF_A_UNUSED FFDisk* disk, FF_A_UNUSED struct mntent* device) {
+    // hasmntopt requires a higher Android API level. Read-only flag is set by `detectStats`
+}
+
+static void detectTypes(FFlist* disks) {
+    FF_LIST_FOR_EACH (FFDisk, currentDisk, *disks) {
+        if (ffStrbufEqualS(&currentDisk->mountpoint, "/") || ffStrbufEqualS(&currentDisk->mountpoint, "/storage/emulated")) {
+            currentDisk->type = FF_DISK_VOLUME_TYPE_REGULAR_BIT;
+        } else if (ffStrbufStartsWithS(&currentDisk->mountpoint, "/mnt/media_rw/")) {
+            currentDisk->type = FF_DISK_VOLUME_TYPE_EXTERNAL_BIT;
+        } else {
+            currentDisk->type = FF_DISK_VOLUME_TYPE_HIDDEN_BIT;
+        }
     }
 }
 
 #else
 
-static bool isSubvolume(const FFlist* disks, FFDisk* currentDisk) {
-    if (ffStrbufEqualS(&currentDisk->mountFrom, "drvfs")) { // WSL Windows drives
-        return false;
+// Open addressing hash set of mount sources, used to find subvolumes in O(n)
+typedef struct FFDiskSourceSet {
+    uint32_t mask;
+    struct {
+        const char* chars; // NULL if the slot is empty
+        uint32_t length;
+    }* slots;
+} FFDiskSourceSet;
+
+static void sourceSetInit(FFDiskSourceSet* set, uint32_t count) {
+    uint32_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    set->mask = capacity - 1;
+    set->slots = calloc(capacity, sizeof(*set->slots));
+}
+
+// Returns true if the source is already in the set; otherwise adds it
+static bool sourceSetTestAndAdd(FFDiskSourceSet* set, const char* chars, uint32_t length) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (uint32_t i = 0; i < length; ++i) {
+        hash = (hash ^ (uint8_t) chars[i]) * 16777619u;
     }
 
-    if (ffStrbufEqualS(&currentDisk->filesystem, "zfs")) {
-        // ZFS subvolumes
-        uint32_t index = ffStrbufFirstIndexC(&currentDisk->mountFrom, '/');
-        if (index == currentDisk->mountFrom.length) {
+    for (uint32_t i = hash & set->mask;; i = (i + 1) & set->mask) {
+        if (set->slots[i].chars == NULL) {
+            set->slots[i].chars = chars;
+            set->slots[i].length = length;
             return false;
         }
-
-        FF_STRBUF_AUTO_DESTROY zpoolName = ffStrbufCreateNS(index, currentDisk->mountFrom.chars);
-        for (uint32_t i = 0; i < disks->length - 1; i++) {
-            const FFDisk* otherDevice = FF_LIST_GET(FFDisk, *disks, i);
-            if (ffStrbufEqualS(&otherDevice->filesystem, "zfs") && ffStrbufStartsWith(&otherDevice->mountFrom, &zpoolName)) {
-                return true;
-            }
+        if (set->slots[i].length == length && memcmp(set->slots[i].chars, chars, length) == 0) {
+            return true;
         }
+    }
+}
 
-        return false;
-    } else {
-        // Filter all disks which device was already found. This catches BTRFS subvolumes.
-        for (uint32_t i = 0; i < disks->length - 1; i++) {
-            const FFDisk* otherDevice = FF_LIST_GET(FFDisk, *disks, i);
-
-            if (ffStrbufEqual(&currentDisk->mountFrom, &otherDevice->mountFrom)) {
-                return true;
-            }
-        }
+static bool isSubvolume(FFDiskSourceSet* sources, FFDiskSourceSet* zpools, FFDisk* currentDisk) {
+    if (ffStrbufEqualS(&currentDisk->filesystem, "zfs")) {
+        // ZFS subvolumes: another dataset of the same pool was already found
+        uint32_t index = ffStrbufFirstIndexC(&currentDisk->mountFrom, '/');
+        bool found = sourceSetTestAndAdd(zpools, currentDisk->mountFrom.chars, index);
+        sourceSetTestAndAdd(sources, currentDisk->mountFrom.chars, currentDisk->mountFrom.length);
+        return found && index < currentDisk->mountFrom.length;
     }
 
-    return false;
+    // Filter all disks which device was already found. This catches BTRFS subvolumes.
+    bool found = sourceSetTestAndAdd(sources, currentDisk->mountFrom.chars, currentDisk->mountFrom.length);
+    return found && !ffStrbufEqualS(&currentDisk->mountFrom, "drvfs"); // WSL Windows drives
 }
 
 static bool isRemovable(FFDisk* currentDisk) {
@@ -231,21 +256,40 @@ static bool isRemovable(FFDisk* currentDisk) {
     return ffReadFileData(sysBlockVolume, 1, &removableChar) > 0 && removableChar == '1';
 }
 
-static void detectType(const FFlist* disks, FFDisk* currentDisk, struct mntent* device) {
+static void detectMountFlags(FFDisk* disk, struct mntent* device) {
     if (hasmntopt(device, "x-gvfs-hide") || hasmntopt(device, "hidden")) {
-        currentDisk->type = FF_DISK_VOLUME_TYPE_HIDDEN_BIT;
-    } else if (isSubvolume(disks, currentDisk)) {
-        currentDisk->type = FF_DISK_VOLUME_TYPE_SUBVOLUME_BIT;
-    } else if (isRemovable(currentDisk)) {
-        currentDisk->type = FF_DISK_VOLUME_TYPE_EXTERNAL_BIT;
-    } else {
-        currentDisk->type = FF_DISK_VOLUME_TYPE_REGULAR_BIT;
+        disk->type = FF_DISK_VOLUME_TYPE_HIDDEN_BIT;
     }
     if (hasmntopt(device, MNTOPT_RO)) {
-        currentDisk->type |= FF_DISK_VOLUME_TYPE_READONLY_BIT;
+        disk->type |= FF_DISK_VOLUME_TYPE_READONLY_BIT;
     }
 }
 
+static void detectTypes(FFlist* disks) {
+    FFDiskSourceSet sources, zpools;
+    sourceSetInit(&sources, disks->length);
+    sourceSetInit(&zpools, disks->length);
+
+    // In mount order, so that the first mount of a device is not a subvolume
+    FF_LIST_FOR_EACH (FFDisk, currentDisk, *disks) {
+        bool subvolume = isSubvolume(&sources, &zpools, currentDisk); // Hidden mounts must be recorded too
+        if (currentDisk->type & FF_DISK_VOLUME_TYPE_HIDDEN_BIT) {
+            continue;
+        }
+
+        if (subvolume) {
+            currentDisk->type |= FF_DISK_VOLUME_TYPE_SUBVOLUME_BIT;
+        } else if (isRemovable(currentDisk)) {
+            currentDisk->type |= FF_DISK_VOLUME_TYPE_EXTERNAL_BIT;
+        } else {
+            currentDisk->type |= FF_DISK_VOLUME_TYPE_REGULAR_BIT;
+        }
+    }
+
+    free(sources.slots);
+    free(zpools.slots);
+}
+
 #endif
 
 static void detectStats(FFDisk* disk) {
@@ -282,6 +326,164 @@ static void detectStats(FFDisk* disk) {
 #endif
 }
 
+#ifdef FF_HAVE_THREADS
+
+enum { FF_DISK_MAX_STAT_THREADS = 16 };
+
+typedef struct FFDiskStatsJob {
+    FFDisk disk;    // Only `mountpoint` and `mountFrom` are set. The worker fills in the name and the stats
+    uint32_t index; // Index of the disk in the list
+    bool done;
+} FFDiskStatsJob;
+
+// Shared by the main thread and the workers. Whoever drops the last reference frees it,
+// so that workers stuck in a hung mount (NFS, FUSE, autofs) can be abandoned safely
+typedef struct FFDiskStatsBatch {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t refs;
+    uint32_t next;     // Index of the next job to run. Set to `count` once the main thread gives up
+    uint32_t finished; // Number of done jobs
+    uint32_t count;
+    FFDiskStatsJob jobs[];
+} FFDiskStatsBatch;
+
+// Must be called with `batch->mutex` locked
+static void releaseStatsBatch(FFDiskStatsBatch* batch) {
+    bool last = --batch->refs == 0;
+    pthread_mutex_unlock(&batch->mutex);
+    if (!last) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < batch->count; ++i) {
+        ffStrbufDestroy(&batch->jobs[i].disk.mountpoint);
+        ffStrbufDestroy(&batch->jobs[i].disk.mountFrom);
+        ffStrbufDestroy(&batch->jobs[i].disk.name);
+    }
+    pthread_cond_destroy(&batch->cond);
+    pthread_mutex_destroy(&batch->mutex);
+    free(batch);
+}
+
+static void runStatsWorker(FFDiskStatsBatch* batch) {
+    pthread_mutex_lock(&batch->mutex);
+    while (batch->next < batch->count) {
+        FFDiskStatsJob* job = &batch->jobs[batch->next++];
+        pthread_mutex_unlock(&batch->mutex);
+
+        detectName(&job->disk); // `stat`s the mount source, which may live on a hung mount too
+        detectStats(&job->disk);
+
+        pthread_mutex_lock(&batch->mutex);
+        job->done = true;
+        ++batch->finished;
+        pthread_cond_signal(&batch->cond);
+    }
+    releaseStatsBatch(batch);
+}
+FF_THREAD_ENTRY_DECL_WRAPPER(runStatsWorker, FFDiskStatsBatch*)
+
+static void getDeadline(struct timespec* deadline, uint32_t timeout) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout / 1000;
+    deadline->tv_nsec += (long) (timeout % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        ++deadline->tv_sec;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+// Mountpoints that timed out before. Their workers may still be stuck, so they are not queried again
+static FFlist unresponsiveMountpoints; // List of FFstrbuf
+
+static void markUnresponsiveDisks(FFlist* disks) {
+    FF_LIST_FOR_EACH (FFDisk, disk, *disks) {
+        FF_LIST_FOR_EACH (FFstrbuf, mountpoint, unresponsiveMountpoints) {
+            if (ffStrbufEqual(mountpoint, &disk->mountpoint)) {
+                disk->type |= FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT;
+                break;
+            }
+        }
+    }
+}
+
+// Runs `detectName` and `detectStats` in worker threads. Gives up once no mount has responded for `timeout` ms,
+// and marks all disks not done by then as unresponsive. Returns false if no worker could be started
+static bool detectStatsParallel(FFlist* disks, uint32_t timeout) {
+    FFDiskStatsBatch* batch = calloc(1, sizeof(*batch) + disks->length * sizeof(*batch->jobs));
+    pthread_mutex_init(&batch->mutex, NULL);
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&batch->cond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+    batch->refs = 1;
+    for (uint32_t i = 0; i < disks->length; ++i) {
+        const FFDisk* disk = FF_LIST_GET(FFDisk, *disks, i);
+        if (disk->type & FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT) {
+            continue;
+        }
+        FFDiskStatsJob* job = &batch->jobs[batch->count++];
+        job->index = i;
+        ffStrbufInitCopy(&job->disk.mountpoint, &disk->mountpoint);
+        ffStrbufInitCopy(&job->disk.mountFrom, &disk->mountFrom);
+        ffStrbufInit(&job->disk.name);
+    }
+
+    pthread_mutex_lock(&batch->mutex);
+
+    uint32_t nThreads = batch->count < FF_DISK_MAX_STAT_THREADS ? batch->count : FF_DISK_MAX_STAT_THREADS;
+    for (uint32_t i = 0; i < nThreads; ++i) {
+        FFThreadType thread = ffThreadCreate(runStatsWorkerThreadMain, batch);
+        if (!thread) {
+            break;
+        }
+        ffThreadDetach(thread);
+        ++batch->refs;
+    }
+    if (batch->refs == 1 && batch->count > 0) {
+        releaseStatsBatch(batch);
+        return false;
+    }
+
+    uint32_t lastFinished = UINT32_MAX;
+    struct timespec deadline;
+    while (batch->finished < batch->count) {
+        if (batch->finished != lastFinished) {
+            lastFinished = batch->finished;
+            getDeadline(&deadline, timeout);
+        }
+        if (pthread_cond_timedwait(&batch->cond, &batch->mutex, &deadline) == ETIMEDOUT && batch->finished == lastFinished) {
+            break;
+        }
+    }
+    batch->next = batch->count; // Don't start the remaining jobs; their workers are stuck anyway
+
+    for (uint32_t i = 0; i < batch->count; ++i) {
+        FFDiskStatsJob* job = &batch->jobs[i];
+        FFDisk* disk = FF_LIST_GET(FFDisk, *disks, job->index);
+        if (!job->done) {
+            disk->type |= FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT;
+            ffStrbufInitCopy(FF_LIST_ADD(FFstrbuf, unresponsiveMountpoints), &disk->mountpoint);
+            continue;
+        }
+        ffStrbufSet(&disk->name, &job->disk.name);
+        disk->type |= job->disk.type;
+        disk->bytesTotal = job->disk.bytesTotal;
+        disk->bytesFree = job->disk.bytesFree;
+        disk->bytesAvailable = job->disk.bytesAvailable;
+        disk->filesUsed = job->disk.filesUsed;
+        disk->filesTotal = job->disk.filesTotal;
+        disk->createTime = job->disk.createTime;
+    }
+
+    releaseStatsBatch(batch);
+    return true;
+}
+
+#endif
+
 const char* ffDetectDisksImpl(FFDiskOptions* options, FFlist* disks) {
     FILE* mountsFile = setmntent("/proc/mounts", "r");
     if (mountsFile == NULL) {
@@ -309,7 +511,7 @@ const char* ffDetectDisksImpl(FFDiskOptions* options, FFlist* disks) {
 
         // We have a valid device, add it to the list
         FFDisk* disk = FF_LIST_ADD(FFDisk, *disks);
-        disk->type = FF_DISK_VOLUME_TYPE_NONE;
+        memset(disk, 0, sizeof(*disk)); // Stats of unresponsive mounts are left as 0
 
         // detect mountFrom
         ffStrbufInitS(&disk->mountFrom, device->mnt_fsname);
@@ -320,18 +522,33 @@ const char* ffDetectDisksImpl(FFDiskOptions* options, FFlist* disks) {
         // detect filesystem
         ffStrbufInitS(&disk->filesystem, device->mnt_type);
 
-        // detect name
+        // detect name, together with the stats
         ffStrbufInit(&disk->name);
-        detectName(disk); // Also detects external devices
-
-        // detect type
-        detectType(disks, disk, device);
 
-        // Detects stats
-        detectStats(disk);
+        // detect hidden and read-only flags, which need the mount options
+        detectMountFlags(disk, device);
     }
 
     endmntent(mountsFile);
 
+    // detect type
+    detectTypes(disks);
+
+    // Detects names and stats. stat and statvfs block forever on a hung network mount
+#ifdef FF_HAVE_THREADS
+    markUnresponsiveDisks(disks);
+    if (options->timeout > 0 && disks->length > 0 && instance.config.general.multithreading && detectStatsParallel(disks, options->timeout)) {
+        return NULL;
+    }
+#endif
+
+    FF_LIST_FOR_EACH (FFDisk, disk, *disks) {
+        if (disk->type & FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT) {
+            continue;
+        }
+        detectName(disk);
+        detectStats(disk);
+    }
+
     return NULL;
 }
@@ -1,12 +1,29 @@
 #include "diskio.h"
 
+#include "common/sampler.h"
 #include "common/time.h"
 
-const char* ffDiskIOGetIoCounters(FFlist* result, FFDiskIOOptions* options);
-
 static FFlist ioCounters1;
 static uint64_t time1;
 
+// Replace the first sample with an older one taken by `fastfetch --sampler`, so that we don't need to wait
+static void loadFromSampler(uint32_t waitTime) {
+    uint64_t sampleTime = ffSamplerLoad(waitTime);
+    if (sampleTime == 0) {
+        return;
+    }
+
+    FF_LIST_FOR_EACH (FFDiskIOResult, ic, ioCounters1) {
+        if (!ffSamplerFindDiskIO(ic->devPath.chars)) {
+            return;
+        }
+    }
+    FF_LIST_FOR_EACH (FFDiskIOResult, ic, ioCounters1) {
+        memcpy(&ic->bytesRead, ffSamplerFindDiskIO(ic->devPath.chars), sizeof(uint64_t) * 4);
+    }
+    time1 = sampleTime;
+}
+
 void ffPrepareDiskIO(FFDiskIOOptions* options) {
     if (options->detectTotal) {
         return;
@@ -46,6 +63,9 @@ const char* ffDetectDiskIO(FFlist* result, FFDiskIOOptions* options) {
     }
 
     uint64_t time2 = ffTimeGetNow();
+    if (time2 - time1 < options->waitTime) {
+        loadFromSampler(options->waitTime);
+    }
     while (time2 - time1 < options->waitTime) {
         ffTimeSleep((uint32_t) (options->waitTime - (time2 - time1)));
         time2 = ffTimeGetNow();
@@ -73,7 +93,7 @@ const char* ffDetectDiskIO(FFlist* result, FFDiskIOOptions* options) {
             uint64_t* currValue = (uint64_t*) ((uint8_t*) icCurr + off);
             uint64_t temp = *currValue;
             *currValue -= *prevValue;
-            *currValue /= (time2 - time1) / 1000 /* seconds */;
+            *currValue = *currValue * 1000 / (time2 - time1); // per second
 
             // For next function call
             *prevValue = temp;
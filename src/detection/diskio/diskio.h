@@ -13,3 +13,4 @@ typedef struct FFDiskIOResult {
 } FFDiskIOResult;
 
 const char* ffDetectDiskIO(FFlist* result, FFDiskIOOptions* options);
+const char* ffDiskIOGetIoCounters(FFlist* result, FFDiskIOOptions* options);
@@ -2,29 +2,33 @@
 #include "common/io.h"
 #include "common/properties.h"
 #include "common/strutil.h"
+#include "common/sysfs.h"
 
 #include <ctype.h>
 #include <limits.h>
 #include <inttypes.h>
 #include <fcntl.h>
 
-static const char* parseDiskIOCounters(int dfd, const char* devName, FFlist* result, FFDiskIOOptions* options) {
-    FF_AUTO_CLOSE_FD int devfd = openat(dfd, "device", O_RDONLY | O_CLOEXEC | O_PATH | O_DIRECTORY);
-    if (devfd < 0) {
+static const char* parseDiskIOCounters(FFSysfsDevice* sysfs, const char* devName, FFlist* result, FFDiskIOOptions* options) {
+    int dfd = ffSysfsGetDeviceFd(sysfs);
+    if (faccessat(dfd, "device", F_OK, 0) != 0) {
         return "virtual device";
     }
 
     FF_STRBUF_AUTO_DESTROY name = ffStrbufCreate();
 
     {
-        if (ffAppendFileBufferRelative(devfd, "vendor", &name)) {
+        if (ffSysfsReadAttr(sysfs, "device/vendor", &name)) {
             ffStrbufTrimRightSpace(&name);
             if (name.length > 0) {
                 ffStrbufAppendC(&name, ' ');
             }
         }
 
-        ffAppendFileBufferRelative(devfd, "model", &name);
+        FF_STRBUF_AUTO_DESTROY model = ffStrbufCreate();
+        if (ffSysfsReadAttr(sysfs, "device/model", &model)) {
+            ffStrbufAppend(&name, &model);
+        }
         ffStrbufTrimRightSpace(&name);
 
         if (name.length == 0) {
@@ -35,8 +39,8 @@ static const char* parseDiskIOCounters(int dfd, const char* devName, FFlist* res
                 bool multiNs = nsid > 1;
                 if (!multiNs) {
                     char pathSysBlock[16];
-                    snprintf(pathSysBlock, ARRAY_SIZE(pathSysBlock), "nvme%dn2", devid);
-                    multiNs = faccessat(devfd, pathSysBlock, F_OK, 0) == 0;
+                    snprintf(pathSysBlock, ARRAY_SIZE(pathSysBlock), "device/nvme%dn2", devid);
+                    multiNs = faccessat(dfd, pathSysBlock, F_OK, 0) == 0;
                 }
                 if (multiNs) {
                     // In Asahi Linux, there are multiple namespaces for the same NVMe drive.
@@ -53,13 +57,11 @@ static const char* parseDiskIOCounters(int dfd, const char* devName, FFlist* res
     // I/Os merges sectors ticks ...
     uint64_t nRead, sectorRead, nWritten, sectorWritten;
     {
-        char sysBlockStat[PROC_FILE_BUFFSIZ];
-        ssize_t fileSize = ffReadFileDataRelative(dfd, "stat", ARRAY_SIZE(sysBlockStat) - 1, sysBlockStat);
-        if (fileSize <= 0) {
+        FF_STRBUF_AUTO_DESTROY sysBlockStat = ffStrbufCreate();
+        if (!ffSysfsReadAttr(sysfs, "stat", &sysBlockStat)) {
             return "failed to read stat file";
         }
-        sysBlockStat[fileSize] = '\0';
-        if (sscanf(sysBlockStat, "%" PRIu64 "%*u%" PRIu64 "%*u%" PRIu64 "%*u%" PRIu64 "%*u", &nRead, &sectorRead, &nWritten, &sectorWritten) <= 0) {
+        if (sscanf(sysBlockStat.chars, "%" PRIu64 "%*u%" PRIu64 "%*u%" PRIu64 "%*u%" PRIu64 "%*u", &nRead, &sectorRead, &nWritten, &sectorWritten) <= 0) {
             return "invalid stat file format";
         }
     }
@@ -89,9 +91,9 @@ const char* ffDiskIOGetIoCounters(FFlist* result, FFDiskIOOptions* options) {
             continue;
         }
 
-        FF_AUTO_CLOSE_FD int dfd = openat(dirfd(sysBlockDirp), devName, O_RDONLY | O_CLOEXEC | O_PATH | O_DIRECTORY);
-        if (dfd > 0) {
-            parseDiskIOCounters(dfd, devName, result, options);
+        FFSysfsDevice* sysfs = ffSysfsGetDevice("/sys/block", devName);
+        if (sysfs) {
+            parseDiskIOCounters(sysfs, devName, result, options);
         }
     }
 
@@ -21,6 +21,8 @@
 #elif __NetBSD__
     #include <sys/types.h>
     #include <sys/sysctl.h>
+#elif __linux__ || __GNU__
+    #include "common/proctable.h"
 #endif
 
 static const char* parseEnv(void) {
@@ -370,48 +372,32 @@ static const char* getFromProcesses(FFDisplayServerResult* result) {
         }
     }
 #elif __linux__ || __GNU__
-    FF_AUTO_CLOSE_DIR DIR* procdir = opendir("/proc");
-    if (procdir == NULL) {
-        return "opendir(\"/proc\") failed";
+    const FFProcTable* table = ffProcTableGet();
+    if (table == NULL) {
+        return "Failed to read processes from /proc";
     }
 
-    FF_STRBUF_AUTO_DESTROY procPath = ffStrbufCreateA(64);
-    ffStrbufAppendS(&procPath, "/proc/");
-
-    uint32_t procPathLength = procPath.length;
-
+    char procPath[64];
     FF_STRBUF_AUTO_DESTROY loginuid = ffStrbufCreate();
     FF_STRBUF_AUTO_DESTROY processName = ffStrbufCreateA(256); // Some processes have large command lines (looking at you chrome)
 
-    struct dirent* dirent;
-    while ((dirent = readdir(procdir)) != NULL) {
-        // Match only folders starting with a number (the pid folders)
-        if (dirent->d_type != DT_DIR || !ffCharIsDigit(dirent->d_name[0])) {
-            continue;
-        }
-
-        ffStrbufAppendS(&procPath, dirent->d_name);
-        uint32_t procFolderPathLength = procPath.length;
-
+    FF_LIST_FOR_EACH (FFProcTableEntry, proc, table->entries) {
         // Don't check for processes not owned by the current user.
-        ffStrbufAppendS(&procPath, "/loginuid");
-        ffReadFileBuffer(procPath.chars, &loginuid);
-        if (ffStrbufToUInt(&loginuid, (uint64_t) -1) != userId) {
-            ffStrbufSubstrBefore(&procPath, procPathLength);
+        // The login uid also matches session processes started as another user, e.g. by the display manager
+        snprintf(procPath, sizeof(procPath), "/proc/%d/loginuid", (int) proc->pid);
+        if (!ffReadFileBuffer(procPath, &loginuid) || ffStrbufToUInt(&loginuid, (uint64_t) -1) != userId) {
             continue;
         }
 
-        ffStrbufSubstrBefore(&procPath, procFolderPathLength);
-
         // We check the cmdline for the process name, because it is not trimmed.
-        ffStrbufAppendS(&procPath, "/cmdline");
-        ffReadFileBuffer(procPath.chars, &processName);
+        snprintf(procPath, sizeof(procPath), "/proc/%d/cmdline", (int) proc->pid);
+        if (!ffReadFileBuffer(procPath, &processName)) {
+            continue;
+        }
         ffStrbufTrimRightSpace(&processName);
         ffStrbufSubstrBeforeFirstC(&processName, '\0'); // Trim the arguments
         ffStrbufSubstrAfterLastC(&processName, '/');
 
-        ffStrbufSubstrBefore(&procPath, procPathLength);
-
         if (result->dePrettyName.length == 0) {
             applyPrettyNameIfDE(result, processName.chars);
         }
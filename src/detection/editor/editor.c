@@ -4,6 +4,7 @@
 #include "common/strutil.h"
 #include "common/path.h"
 #include "common/binary.h"
+#include "common/resultcache.h"
 
 #include <stdlib.h>
 
@@ -32,7 +33,39 @@ static bool extractNanoVersionFromBinary(const char* str, FF_A_UNUSED uint32_t l
     return false;
 }
 
-const char* ffDetectEditor(FFEditorResult* result) {
+// Version probe spawned by `ffPrepareEditor`
+static FFProcessFuture* preparedVersion;
+
+static const char* getVersionParam(const FFstrbuf* exe) {
+    if (
+        ffStrbufEqualS(exe, "nano") ||
+        ffStrbufEqualS(exe, "vim") ||
+        ffStrbufStartsWithS(exe, "vim.") || // vim.basic/vim.tiny
+        ffStrbufEqualS(exe, "nvim") ||
+        ffStrbufEqualS(exe, "micro") ||
+        ffStrbufEqualS(exe, "emacs") ||
+        ffStrbufStartsWithS(exe, "emacs-") || // emacs-29.3
+        ffStrbufEqualS(exe, "hx") ||
+        ffStrbufEqualS(exe, "code") ||
+        ffStrbufEqualS(exe, "pluma") ||
+        ffStrbufEqualS(exe, "sublime_text") ||
+        ffStrbufEqualS(exe, "zeditor")) {
+        return "--version";
+    }
+    if (
+        ffStrbufEqualS(exe, "kak") ||
+        ffStrbufEqualS(exe, "pico")) {
+        return "-version";
+    }
+    if (
+        ffStrbufEqualS(exe, "ne")) {
+        return "-h";
+    }
+    return NULL;
+}
+
+// Sets `result->exe` on success
+static const char* detectEditorPath(FFEditorResult* result) {
     ffStrbufSetS(&result->name, getenv("VISUAL"));
     if (result->name.length) {
         result->type = "Visual";
@@ -91,10 +124,37 @@ const char* ffDetectEditor(FFEditorResult* result) {
 #endif
     }
 
-    if (!instance.config.general.detectVersion) {
-        return NULL;
+    return NULL;
+}
+
+void ffPrepareEditor(void) {
+    if (!instance.config.general.detectVersion || preparedVersion) {
+        return;
+    }
+
+    FFEditorResult result = {
+        .name = ffStrbufCreate(),
+        .path = ffStrbufCreate(),
+        .exe = ffStrbufCreate(),
+        .version = ffStrbufCreate(),
+    };
+    // nvim, vim and nano versions are usually extracted from their binaries
+    if (detectEditorPath(&result) == NULL && result.exe.length > 0 &&
+        !ffStrbufEqualS(&result.exe, "nvim") && !ffStrbufStartsWithS(&result.exe, "vim") && !ffStrbufEqualS(&result.exe, "nano") &&
+        !ffResultCacheGetExeVersion("Editor", result.exe.chars, result.path.chars, &result.version)) {
+        const char* param = getVersionParam(&result.exe);
+        if (param && ffProcessSpawnAsync((char* const[]) { result.path.chars, (char*) param, NULL }, false, &preparedVersion) != NULL) {
+            preparedVersion = NULL;
+        }
     }
 
+    ffStrbufDestroy(&result.name);
+    ffStrbufDestroy(&result.path);
+    ffStrbufDestroy(&result.exe);
+    ffStrbufDestroy(&result.version);
+}
+
+static void detectVersion(FFEditorResult* result) {
     if (ffStrbufEqualS(&result->exe, "nvim")) {
         ffBinaryExtractStrings(result->path.chars, extractNvimVersionFromBinary, &result->version, (uint32_t) strlen("NVIM v0.0.0"));
     } else if (ffStrbufEqualS(&result->exe, "vim") || ffStrbufStartsWithS(&result->exe, "vim.")) {
@@ -104,43 +164,27 @@ const char* ffDetectEditor(FFEditorResult* result) {
     }
 
     if (result->version.length > 0) {
-        return NULL;
+        return;
     }
 
-    const char* param = NULL;
-    if (
-        ffStrbufEqualS(&result->exe, "nano") ||
-        ffStrbufEqualS(&result->exe, "vim") ||
-        ffStrbufStartsWithS(&result->exe, "vim.") || // vim.basic/vim.tiny
-        ffStrbufEqualS(&result->exe, "nvim") ||
-        ffStrbufEqualS(&result->exe, "micro") ||
-        ffStrbufEqualS(&result->exe, "emacs") ||
-        ffStrbufStartsWithS(&result->exe, "emacs-") || // emacs-29.3
-        ffStrbufEqualS(&result->exe, "hx") ||
-        ffStrbufEqualS(&result->exe, "code") ||
-        ffStrbufEqualS(&result->exe, "pluma") ||
-        ffStrbufEqualS(&result->exe, "sublime_text") ||
-        ffStrbufEqualS(&result->exe, "zeditor")) {
-        param = "--version";
-    } else if (
-        ffStrbufEqualS(&result->exe, "kak") ||
-        ffStrbufEqualS(&result->exe, "pico")) {
-        param = "-version";
-    } else if (
-        ffStrbufEqualS(&result->exe, "ne")) {
-        param = "-h";
+    if (preparedVersion) {
+        ffProcessFutureGet(preparedVersion, &result->version);
+        preparedVersion = NULL;
     } else {
-        return NULL;
-    }
+        const char* param = getVersionParam(&result->exe);
+        if (!param) {
+            return;
+        }
 
-    ffProcessAppendStdOut(&result->version, (char* const[]) {
-                                                result->path.chars,
-                                                (char*) param,
-                                                NULL,
-                                            });
+        ffProcessAppendStdOut(&result->version, (char* const[]) {
+                                                    result->path.chars,
+                                                    (char*) param,
+                                                    NULL,
+                                                });
+    }
 
     if (result->version.length == 0) {
-        return NULL;
+        return;
     }
 
     ffStrbufSubstrBeforeFirstC(&result->version, '\n');
@@ -155,6 +199,19 @@ const char* ffDetectEditor(FFEditorResult* result) {
             ffStrbufSubstrAfter(&result->version, (uint32_t) (versionStart - result->version.chars - 1));
         }
     }
+}
+
+const char* ffDetectEditor(FFEditorResult* result) {
+    const char* error = detectEditorPath(result);
+    if (error || result->exe.length == 0 || !instance.config.general.detectVersion) {
+        return error;
+    }
+
+    if (ffResultCacheGetExeVersion("Editor", result->exe.chars, result->path.chars, &result->version)) {
+        return NULL;
+    }
 
+    detectVersion(result);
+    ffResultCacheSetExeVersion("Editor", result->exe.chars, result->path.chars, &result->version);
     return NULL;
 }
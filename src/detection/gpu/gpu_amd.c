@@ -110,7 +110,6 @@ const char* ffDetectAmdGpuInfo(const FFGpuDriverCondition* cond, FFGpuDriverResu
         }
 
         atexit(shutdownAdl);
-        atiadl = NULL; // don't close atiadl
         FF_DEBUG("ADL initialization complete");
     }
 
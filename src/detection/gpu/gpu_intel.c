@@ -58,7 +58,6 @@ const char* ffDetectIntelGpuInfo(const FFGpuDriverCondition* cond, FFGpuDriverRe
             return "loading igcl library failed";
         }
         atexit(shutdownIgcl);
-        libigcl = NULL; // don't close igcl
     }
 
     if (!igclData.apiHandle) {
@@ -70,7 +70,6 @@ const char* ffDetectMthreadsGpuInfo(const FFGpuDriverCondition* cond, FFGpuDrive
             return "mtmlLibraryInitSystem failed";
         }
         atexit(shutdownMtml);
-        libmtml = NULL; // don't close mtml
     }
 
     if (mtmlData.ffmtmlLibraryInitSystem == NULL) {
@@ -72,7 +72,6 @@ static const char* detectMoreByNvapi(FFGpuDriverResult* result) {
         nvapiData.ffnvapi_Unload = ffnvapi_Unload;
 
         atexit((void*) ffnvapi_Unload);
-        libnvapi = NULL; // don't close nvapi
     }
 
     if (nvapiData.ffnvapi_EnumPhysicalGPUs == NULL) {
@@ -177,7 +176,6 @@ const char* ffDetectNvidiaGpuInfo(const FFGpuDriverCondition* cond, FFGpuDriverR
             return "nvmlInit_v2() failed";
         }
         atexit((void*) ffnvmlShutdown);
-        libnvml = NULL; // don't close nvml
     }
 
     if (nvmlData.ffnvmlDeviceGetNumGpuCores == NULL) {
@@ -4,7 +4,10 @@
 #include "common/memrchr.h"
 #include "common/strutil.h"
 
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #ifdef __FreeBSD__
     #include <paths.h>
     #ifndef _PATH_LOCALBASE
@@ -23,98 +26,261 @@
     #include "fastfetch_amdgpuids.c.inc"
 #endif
 
-static const FFstrbuf* loadPciIds() {
-    static FFstrbuf pciids;
+// Binary index of pci.ids, cached in `$cacheDir/fastfetch/pciids.bin` and mapped into memory.
+// Layout: header, vendor buckets, device buckets, name pool. Buckets are open-addressing hash tables
+#define FF_PCIIDS_INDEX_MAGIC "FFPCI1"
 
-    if (pciids.chars) {
-        return &pciids;
-    }
-    ffStrbufInit(&pciids);
+typedef struct FFPciIdsIndexHeader {
+    char magic[8];
+    uint64_t sourceMtime; // Of pci.ids
+    uint64_t sourceSize;
+    uint32_t vendorBuckets; // Power of 2
+    uint32_t deviceBuckets; // Power of 2
+    uint32_t namesSize;
+    uint32_t reserved;
+} FFPciIdsIndexHeader;
+
+typedef struct FFPciIdsIndexEntry {
+    uint32_t key;  // vendor, or (vendor << 16 | device)
+    uint32_t name; // Offset into the name pool; 0 for empty buckets
+} FFPciIdsIndexEntry;
 
+static const char* getPciIdsPath(struct stat* st) {
+    static const char* const paths[] = {
 #ifdef FF_CUSTOM_PCI_IDS_PATH
+        FF_STR(FF_CUSTOM_PCI_IDS_PATH),
+#elif __linux__
+        FASTFETCH_TARGET_DIR_USR "/share/hwdata/pci.ids",
+        FASTFETCH_TARGET_DIR_USR "/share/misc/pci.ids", // debian?
+        FASTFETCH_TARGET_DIR_USR "/local/share/hwdata/pci.ids",
+#elif __OpenBSD__ || __FreeBSD__ || __NetBSD__
+        _PATH_LOCALBASE "/share/hwdata/pci.ids",
+        _PATH_LOCALBASE "/share/pciids/pci.ids",
+#elif __sun
+        FASTFETCH_TARGET_DIR_ROOT "/usr/share/hwdata/pci.ids",
+#elif __HAIKU__
+        FASTFETCH_TARGET_DIR_ROOT "/system/data/hwdata/pci.ids",
+#endif
+        NULL,
+    };
 
-    ffReadFileBuffer(FF_STR(FF_CUSTOM_PCI_IDS_PATH), &pciids);
+    for (const char* const* path = paths; *path; ++path) {
+        if (stat(*path, st) == 0 && S_ISREG(st->st_mode) && st->st_size > 0) {
+            return *path;
+        }
+    }
+    return NULL;
+}
+
+static inline uint32_t pciIdsHash(uint32_t key, uint32_t buckets) {
+    return (key * 0x9E3779B1u) & (buckets - 1); // Fibonacci hashing; `buckets` is a power of 2
+}
+
+static uint32_t pciIdsBucketCount(uint32_t count) {
+    uint32_t buckets = 16;
+    while (buckets < count + count / 2) { // Load factor <= 2/3
+        buckets <<= 1;
+    }
+    return buckets;
+}
 
-#else // FF_CUSTOM_PCI_IDS_PATH
+static void pciIdsInsert(FFPciIdsIndexEntry* table, uint32_t buckets, uint32_t key, uint32_t name) {
+    for (uint32_t i = pciIdsHash(key, buckets);; i = (i + 1) & (buckets - 1)) {
+        if (table[i].name == 0) {
+            table[i] = (FFPciIdsIndexEntry) { .key = key, .name = name };
+            return;
+        }
+        if (table[i].key == key) {
+            return; // Duplicated. Keep the first one
+        }
+    }
+}
 
-    #if __linux__
-    ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/share/hwdata/pci.ids", &pciids);
-    if (pciids.length == 0) {
-        ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/share/misc/pci.ids", &pciids); // debian?
-        if (pciids.length == 0) {
-            ffReadFileBuffer(FASTFETCH_TARGET_DIR_USR "/local/share/hwdata/pci.ids", &pciids);
+static inline bool parseHex4(const char* str, uint32_t* result) {
+    *result = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = str[i];
+        uint32_t digit = c >= '0' && c <= '9' ? (uint32_t) (c - '0') : c >= 'a' && c <= 'f' ? (uint32_t) (c - 'a' + 10)
+                                                                                               : UINT32_MAX;
+        if (digit == UINT32_MAX) {
+            return false;
         }
+        *result = *result << 4 | digit;
     }
-    #elif __OpenBSD__ || __FreeBSD__ || __NetBSD__
-    ffReadFileBuffer(_PATH_LOCALBASE "/share/hwdata/pci.ids", &pciids);
-    if (pciids.length == 0) {
-        ffReadFileBuffer(_PATH_LOCALBASE "/share/pciids/pci.ids", &pciids);
+    return str[4] == ' ' && str[5] == ' ';
+}
+
+// Build the index from pci.ids. Returns false if the file can't be read
+static bool buildPciIdsIndex(const char* path, const struct stat* st, FFstrbuf* index) {
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    if (!ffReadFileBuffer(path, &content) || content.length == 0) {
+        return false;
     }
-    #elif __sun
-    ffReadFileBuffer(FASTFETCH_TARGET_DIR_ROOT "/usr/share/hwdata/pci.ids", &pciids);
-    #elif __HAIKU__
-    ffReadFileBuffer(FASTFETCH_TARGET_DIR_ROOT "/system/data/hwdata/pci.ids", &pciids);
-    #endif
 
-#endif // FF_CUSTOM_PCI_IDS_PATH
+    FF_LIST_AUTO_DESTROY vendors = ffListCreate(); // FFPciIdsIndexEntry
+    FF_LIST_AUTO_DESTROY devices = ffListCreate(); // FFPciIdsIndexEntry
+    FF_STRBUF_AUTO_DESTROY names = ffStrbufCreateA(content.length / 2);
+    ffStrbufAppendC(&names, '\0'); // Offset 0 marks empty buckets
+
+    uint32_t vendor = UINT32_MAX;
+    char* line = NULL;
+    size_t len = 0;
+    while (ffStrbufGetline(&line, &len, &content)) {
+        if (line[0] == 'C' && line[1] == ' ') {
+            break; // Known device classes; not used
+        }
+
+        uint32_t id;
+        FFPciIdsIndexEntry* entry;
+        if (line[0] != '\t' && len > 6 && parseHex4(line, &id)) {
+            vendor = id;
+            entry = FF_LIST_ADD(FFPciIdsIndexEntry, vendors);
+            *entry = (FFPciIdsIndexEntry) { .key = id };
+        } else if (line[0] == '\t' && line[1] != '\t' && len > 7 && vendor != UINT32_MAX && parseHex4(line + 1, &id)) {
+            entry = FF_LIST_ADD(FFPciIdsIndexEntry, devices);
+            *entry = (FFPciIdsIndexEntry) { .key = vendor << 16 | id };
+        } else {
+            continue; // Comments, subsystems
+        }
 
-    return &pciids;
+        const char* name = line + (line[0] == '\t' ? 7 : 6);
+        entry->name = names.length;
+        ffStrbufAppendNS(&names, (uint32_t) (len - (size_t) (name - line)), name);
+        ffStrbufAppendC(&names, '\0');
+    }
+
+    FFPciIdsIndexHeader header = {
+        .magic = FF_PCIIDS_INDEX_MAGIC,
+        .sourceMtime = (uint64_t) st->st_mtime,
+        .sourceSize = (uint64_t) st->st_size,
+        .vendorBuckets = pciIdsBucketCount(vendors.length),
+        .deviceBuckets = pciIdsBucketCount(devices.length),
+        .namesSize = names.length,
+    };
+    uint32_t tablesSize = (header.vendorBuckets + header.deviceBuckets) * (uint32_t) sizeof(FFPciIdsIndexEntry);
+
+    ffStrbufEnsureFree(index, (uint32_t) sizeof(header) + tablesSize + names.length);
+    ffStrbufAppendNS(index, sizeof(header), (const char*) &header);
+    FFPciIdsIndexEntry* tables = (FFPciIdsIndexEntry*) (index->chars + index->length);
+    memset(tables, 0, tablesSize);
+    index->length += tablesSize;
+    ffStrbufAppendNS(index, names.length, names.chars);
+
+    FF_LIST_FOR_EACH (FFPciIdsIndexEntry, entry, vendors) {
+        pciIdsInsert(tables, header.vendorBuckets, entry->key, entry->name);
+    }
+    FF_LIST_FOR_EACH (FFPciIdsIndexEntry, entry, devices) {
+        pciIdsInsert(tables + header.vendorBuckets, header.deviceBuckets, entry->key, entry->name);
+    }
+    return true;
 }
 
-static void parsePciIdsFile(const FFstrbuf* content, uint8_t subclass, uint16_t vendor, uint16_t device, FFGPUResult* gpu) {
-    if (content->length) {
-        char buffer[32];
+static bool isValidPciIdsIndex(const FFPciIdsIndexHeader* header, size_t size, const struct stat* st) {
+    if (size < sizeof(*header) ||
+        memcmp(header->magic, FF_PCIIDS_INDEX_MAGIC, sizeof(FF_PCIIDS_INDEX_MAGIC)) != 0 ||
+        header->sourceMtime != (uint64_t) st->st_mtime ||
+        header->sourceSize != (uint64_t) st->st_size) {
+        return false;
+    }
 
-        // Search for vendor
-        uint32_t len = (uint32_t) snprintf(buffer, ARRAY_SIZE(buffer), "\n%04x  ", vendor);
-        char* start = (char*) memmem(content->chars, content->length, buffer, len);
-        char* end = content->chars + content->length;
-        if (start) {
-            start += len;
-            end = memchr(start, '\n', (uint32_t) (end - start));
-            if (!end) {
-                end = content->chars + content->length;
-            }
-            if (!gpu->vendor.length) {
-                ffStrbufSetNS(&gpu->vendor, (uint32_t) (end - start), start);
-            }
+    if (header->vendorBuckets == 0 || (header->vendorBuckets & (header->vendorBuckets - 1)) ||
+        header->deviceBuckets == 0 || (header->deviceBuckets & (header->deviceBuckets - 1)) ||
+        header->namesSize == 0) {
+        return false;
+    }
+
+    size_t expected = sizeof(*header) + ((size_t) header->vendorBuckets + header->deviceBuckets) * sizeof(FFPciIdsIndexEntry) + header->namesSize;
+    if (size != expected || ((const char*) header)[size - 1] != '\0') {
+        return false;
+    }
+
+    const FFPciIdsIndexEntry* entries = (const FFPciIdsIndexEntry*) (header + 1);
+    for (uint32_t i = 0; i < header->vendorBuckets + header->deviceBuckets; ++i) {
+        if (entries[i].name >= header->namesSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const FFPciIdsIndexHeader* loadPciIdsIndex(void) {
+    static const FFPciIdsIndexHeader* index;
+    static bool loaded;
+
+    if (loaded) {
+        return index;
+    }
+    loaded = true;
+
+    struct stat st;
+    const char* path = getPciIdsPath(&st);
+    if (!path) {
+        return NULL;
+    }
+
+    FF_STRBUF_AUTO_DESTROY indexPath = ffStrbufCreateCopy(&instance.state.platform.cacheDir);
+    ffStrbufEnsureEndsWithC(&indexPath, '/');
+    ffStrbufAppendS(&indexPath, "fastfetch/pciids.bin");
 
-            start = end;     // point to '\n' of vendor
-            end = start + 1; // point to start of devices
-            // find the start of next vendor
-            while (end[0] == '\t' || end[0] == '#') {
-                end = strchr(end, '\n');
-                if (!end) {
-                    end = content->chars + content->length;
-                    break;
-                } else {
-                    end++;
+    {
+        FF_AUTO_CLOSE_FD int fd = open(indexPath.chars, O_RDONLY | O_CLOEXEC);
+        struct stat indexSt;
+        if (fd >= 0 && fstat(fd, &indexSt) == 0 && indexSt.st_size > 0) {
+            void* map = mmap(NULL, (size_t) indexSt.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                if (isValidPciIdsIndex(map, (size_t) indexSt.st_size, &st)) {
+                    index = map; // Leaked until exit
+                    return index;
                 }
+                munmap(map, (size_t) indexSt.st_size);
             }
+        }
+    }
 
-            // Search for device
-            len = (uint32_t) snprintf(buffer, ARRAY_SIZE(buffer), "\n\t%04x  ", device);
-            start = memmem(start, (size_t) (end - start), buffer, len);
-            if (start) {
-                start += len;
-                end = memchr(start, '\n', (uint32_t) (end - start));
-                if (!end) {
-                    end = content->chars + content->length;
-                }
+    FFstrbuf data = ffStrbufCreate();
+    if (!buildPciIdsIndex(path, &st, &data)) {
+        ffStrbufDestroy(&data);
+        return NULL;
+    }
+    ffWriteFileBufferAtomic(indexPath.chars, &data); // Other processes may have the old index mapped
+    index = (const FFPciIdsIndexHeader*) data.chars; // Leaked until exit
+    return index;
+}
 
-                char* closingBracket = end - 1;
-                if (*closingBracket == ']') {
-                    char* openingBracket = memrchr(start, '[', (size_t) (closingBracket - start));
-                    if (openingBracket) {
-                        openingBracket++;
-                        ffStrbufSetNS(&gpu->name, (uint32_t) (closingBracket - openingBracket), openingBracket);
-                    }
-                }
-                if (!gpu->name.length) {
-                    ffStrbufSetNS(&gpu->name, (uint32_t) (end - start), start);
-                }
+static const char* lookupPciIdsIndex(const FFPciIdsIndexHeader* index, uint16_t vendor, int32_t device /* -1 for vendor name */) {
+    const FFPciIdsIndexEntry* table = (const FFPciIdsIndexEntry*) (index + 1);
+    uint32_t buckets = index->vendorBuckets;
+    uint32_t key = vendor;
+    if (device >= 0) {
+        table += index->vendorBuckets;
+        buckets = index->deviceBuckets;
+        key = (uint32_t) vendor << 16 | (uint32_t) device;
+    }
+
+    const char* names = (const char*) (index + 1) + ((size_t) index->vendorBuckets + index->deviceBuckets) * sizeof(FFPciIdsIndexEntry);
+    for (uint32_t i = pciIdsHash(key, buckets), n = 0; n < buckets && table[i].name != 0; i = (i + 1) & (buckets - 1), ++n) {
+        if (table[i].key == key) {
+            return names + table[i].name; // Offsets are checked by `isValidPciIdsIndex`
+        }
+    }
+    return NULL;
+}
+
+// `name` is the device name in pci.ids, or NULL if not found
+static void setGPUName(const char* name, uint8_t subclass, uint16_t device, FFGPUResult* gpu) {
+    if (name) {
+        uint32_t nameLen = (uint32_t) strlen(name);
+        const char* closingBracket = name + nameLen - 1;
+        if (nameLen > 0 && *closingBracket == ']') {
+            const char* openingBracket = memrchr(name, '[', nameLen - 1);
+            if (openingBracket) {
+                openingBracket++;
+                ffStrbufSetNS(&gpu->name, (uint32_t) (closingBracket - openingBracket), openingBracket);
             }
         }
+        if (!gpu->name.length) {
+            ffStrbufSetNS(&gpu->name, nameLen, name);
+        }
     }
 
     if (!gpu->name.length) {
@@ -138,61 +304,44 @@ static void parsePciIdsFile(const FFstrbuf* content, uint8_t subclass, uint16_t
     }
 }
 
+static void loadPciIdsIndexed(uint8_t subclass, uint16_t vendor, uint16_t device, FFGPUResult* gpu) {
+    const FFPciIdsIndexHeader* index = loadPciIdsIndex();
+    const char* name = NULL;
+    if (index) {
+        const char* vendorName = lookupPciIdsIndex(index, vendor, -1);
+        if (vendorName) {
+            if (!gpu->vendor.length) {
+                ffStrbufSetS(&gpu->vendor, vendorName);
+            }
+            name = lookupPciIdsIndex(index, vendor, device);
+        }
+    }
+    setGPUName(name, subclass, device, gpu);
+}
+
 #if FF_HAVE_EMBEDDED_PCIIDS
+static inline int pciVendorCmp(const uint16_t* key, const FFPciVendor* element) {
+    return (int) *key - (int) element->id;
+}
+
 static inline int pciDeviceCmp(const uint16_t* key, const FFPciDevice* element) {
     return (int) *key - (int) element->id;
 }
 
 static bool loadPciidsInc(uint8_t subclass, uint16_t vendor, uint16_t device, FFGPUResult* gpu) {
-    for (const FFPciVendor* pvendor = ffPciVendors; pvendor->name; pvendor++) {
-        if (pvendor->id != vendor) {
-            continue;
-        }
-
-        if (!gpu->vendor.length) {
-            ffStrbufSetS(&gpu->vendor, pvendor->name);
-        }
-
-        const FFPciDevice* pdevice = (const FFPciDevice*) bsearch(&device, pvendor->devices, pvendor->nDevices, sizeof(*pdevice), (void*) pciDeviceCmp);
-
-        if (pdevice) {
-            uint32_t nameLen = (uint32_t) strlen(pdevice->name);
-            const char* closingBracket = pdevice->name + nameLen - 1;
-            if (*closingBracket == ']') {
-                const char* openingBracket = memrchr(pdevice->name, '[', nameLen - 1);
-                if (openingBracket) {
-                    openingBracket++;
-                    ffStrbufSetNS(&gpu->name, (uint32_t) (closingBracket - openingBracket), openingBracket);
-                }
-            }
-            if (!gpu->name.length) {
-                ffStrbufSetNS(&gpu->name, nameLen, pdevice->name);
-            }
-            return true;
-        }
-
-        if (!gpu->name.length) {
-            const char* subclassStr;
-            switch (subclass) {
-                case 0 /*PCI_CLASS_DISPLAY_VGA*/:
-                    subclassStr = " (VGA compatible)";
-                    break;
-                case 1 /*PCI_CLASS_DISPLAY_XGA*/:
-                    subclassStr = " (XGA compatible)";
-                    break;
-                case 2 /*PCI_CLASS_DISPLAY_3D*/:
-                    subclassStr = " (3D)";
-                    break;
-                default:
-                    subclassStr = "";
-                    break;
-            }
+    // The last element is the terminator. Vendors and devices are sorted by `gen-pciids.py`
+    const FFPciVendor* pvendor = (const FFPciVendor*) bsearch(&vendor, ffPciVendors, sizeof(ffPciVendors) / sizeof(*ffPciVendors) - 1, sizeof(*pvendor), (void*) pciVendorCmp);
+    if (!pvendor) {
+        return false;
+    }
 
-            ffStrbufSetF(&gpu->name, "%s Device %04X%s", gpu->vendor.length ? gpu->vendor.chars : "Unknown", device, subclassStr);
-        }
-        return true;
+    if (!gpu->vendor.length) {
+        ffStrbufSetS(&gpu->vendor, pvendor->name);
     }
-    return false;
+
+    const FFPciDevice* pdevice = (const FFPciDevice*) bsearch(&device, pvendor->devices, pvendor->nDevices, sizeof(*pdevice), (void*) pciDeviceCmp);
+    setGPUName(pdevice ? pdevice->name : NULL, subclass, device, gpu);
+    return true;
 }
 #endif
 
@@ -208,7 +357,7 @@ void ffGPUFillVendorAndName(uint8_t subclass, uint16_t vendor, uint16_t device,
         return;
     }
 #endif
-    return parsePciIdsFile(loadPciIds(), subclass, vendor, device, gpu);
+    return loadPciIdsIndexed(subclass, vendor, device, gpu);
 }
 
 #if FF_HAVE_EMBEDDED_AMDGPUIDS
@@ -1,10 +1,29 @@
 #include "netio.h"
 
+#include "common/sampler.h"
 #include "common/time.h"
 
 static FFlist ioCounters1;
 static uint64_t time1;
 
+// Replace the first sample with an older one taken by `fastfetch --sampler`, so that we don't need to wait
+static void loadFromSampler(uint32_t waitTime) {
+    uint64_t sampleTime = ffSamplerLoad(waitTime);
+    if (sampleTime == 0) {
+        return;
+    }
+
+    FF_LIST_FOR_EACH (FFNetIOResult, ic, ioCounters1) {
+        if (!ffSamplerFindNetIO(ic->name.chars)) {
+            return;
+        }
+    }
+    FF_LIST_FOR_EACH (FFNetIOResult, ic, ioCounters1) {
+        memcpy(&ic->txBytes, ffSamplerFindNetIO(ic->name.chars), sizeof(uint64_t) * 8);
+    }
+    time1 = sampleTime;
+}
+
 void ffPrepareNetIO(FFNetIOOptions* options) {
     if (options->detectTotal) {
         return;
@@ -44,6 +63,9 @@ const char* ffDetectNetIO(FFlist* result, FFNetIOOptions* options) {
     }
 
     uint64_t time2 = ffTimeGetNow();
+    if (time2 - time1 < options->waitTime) {
+        loadFromSampler(options->waitTime);
+    }
     while (time2 - time1 < options->waitTime) {
         ffTimeSleep((uint32_t) (options->waitTime - (time2 - time1)));
         time2 = ffTimeGetNow();
@@ -71,7 +93,7 @@ const char* ffDetectNetIO(FFlist* result, FFNetIOOptions* options) {
             uint64_t* currValue = (uint64_t*) ((uint8_t*) icCurr + off);
             uint64_t temp = *currValue;
             *currValue -= *prevValue;
-            *currValue /= (time2 - time1) / 1000 /* seconds */;
+            *currValue = *currValue * 1000 / (time2 - time1); // per second
             *prevValue = temp;
         }
     }
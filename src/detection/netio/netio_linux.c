@@ -3,59 +3,186 @@
 #include "common/io.h"
 #include "common/netif.h"
 #include "common/strutil.h"
+#include "common/sysfs.h"
 
 #include <fcntl.h>
 #include <net/if.h>
+#include <linux/if.h>
+#include <linux/rtnetlink.h>
 
-static void getData(FFstrbuf* buffer, const char* ifName, bool isDefaultRoute, int basefd, FFlist* result) {
-    FF_AUTO_CLOSE_FD int dfd = openat(basefd, ifName, O_RDONLY | O_DIRECTORY);
-    if (dfd < 0) {
+static void getData(FFstrbuf* buffer, const char* ifName, bool isDefaultRoute, FFlist* result) {
+    FFSysfsDevice* device = ffSysfsGetDevice("/sys/class/net", ifName);
+    if (!device) {
         return;
     }
 
-    char operstate;
-    if (!ffReadFileDataRelative(dfd, "operstate", 1, &operstate) || operstate != 'u' /* up or unknown */) {
+    if (!ffSysfsReadAttr(device, "operstate", buffer) || buffer->chars[0] != 'u' /* up or unknown */) {
         return;
     }
 
+    static const char* const names[] = {
+        "statistics/tx_bytes",
+        "statistics/rx_bytes",
+        "statistics/tx_packets",
+        "statistics/rx_packets",
+        "statistics/rx_errors",
+        "statistics/tx_errors",
+        "statistics/rx_dropped",
+        "statistics/tx_dropped",
+    };
+    uint64_t values[sizeof(names) / sizeof(*names)] = {};
+    ffSysfsReadUInts(device, ARRAY_SIZE(names), names, values);
+
     FFNetIOResult* counters = FF_LIST_ADD(FFNetIOResult, *result);
     ffStrbufInitS(&counters->name, ifName);
     counters->defaultRoute = isDefaultRoute;
+    counters->txBytes = values[0];
+    counters->rxBytes = values[1];
+    counters->txPackets = values[2];
+    counters->rxPackets = values[3];
+    counters->rxErrors = values[4];
+    counters->txErrors = values[5];
+    counters->rxDrops = values[6];
+    counters->txDrops = values[7];
+}
 
-    if (ffReadFileBufferRelative(dfd, "statistics/rx_bytes", buffer)) {
-        counters->rxBytes = ffStrbufToUInt(buffer, 0);
+static void parseLink(const struct nlmsghdr* nlh, uint32_t defaultRouteIfIndex, FFNetIOOptions* options, FFlist* result) {
+    const struct ifinfomsg* ifi = NLMSG_DATA(nlh);
+    const char* ifName = NULL;
+    uint8_t operstate = IF_OPER_UNKNOWN;
+    const struct rtattr* statsAttr = NULL;
+
+    size_t len = IFLA_PAYLOAD(nlh);
+    for (const struct rtattr* rta = IFLA_RTA(ifi); RTA_OK(rta, len); rta = RTA_NEXT(rta, len)) {
+        switch (rta->rta_type) {
+            case IFLA_IFNAME:
+                ifName = RTA_DATA(rta);
+                break;
+            case IFLA_OPERSTATE:
+                operstate = *(const uint8_t*) RTA_DATA(rta);
+                break;
+            case IFLA_STATS64:
+                statsAttr = rta;
+                break;
+        }
     }
 
-    if (ffReadFileBufferRelative(dfd, "statistics/tx_bytes", buffer)) {
-        counters->txBytes = ffStrbufToUInt(buffer, 0);
+    // Same as `operstate` being "up" or "unknown" in sysfs
+    if (!ifName || !statsAttr || (operstate != IF_OPER_UP && operstate != IF_OPER_UNKNOWN)) {
+        return;
     }
 
-    if (ffReadFileBufferRelative(dfd, "statistics/rx_packets", buffer)) {
-        counters->rxPackets = ffStrbufToUInt(buffer, 0);
+    if (options->namePrefix.length && strncmp(ifName, options->namePrefix.chars, options->namePrefix.length) != 0) {
+        return;
     }
 
-    if (ffReadFileBufferRelative(dfd, "statistics/tx_packets", buffer)) {
-        counters->txPackets = ffStrbufToUInt(buffer, 0);
+    // The struct grows with kernel versions, and the attribute may not be 8-byte aligned
+    struct rtnl_link_stats64 stats = {};
+    size_t statsSize = RTA_PAYLOAD(statsAttr);
+    if (statsSize < offsetof(struct rtnl_link_stats64, tx_dropped) + sizeof(stats.tx_dropped)) {
+        return;
+    }
+    memcpy(&stats, RTA_DATA(statsAttr), statsSize < sizeof(stats) ? statsSize : sizeof(stats));
+
+    FFNetIOResult* counters = FF_LIST_ADD(FFNetIOResult, *result);
+    ffStrbufInitS(&counters->name, ifName);
+    counters->defaultRoute = (uint32_t) ifi->ifi_index == defaultRouteIfIndex;
+    counters->txBytes = stats.tx_bytes;
+    counters->rxBytes = stats.rx_bytes;
+    counters->txPackets = stats.tx_packets;
+    counters->rxPackets = stats.rx_packets;
+    counters->rxErrors = stats.rx_errors;
+    counters->txErrors = stats.tx_errors;
+    counters->rxDrops = stats.rx_dropped;
+    counters->txDrops = stats.tx_dropped;
+}
+
+// A single RTM_GETLINK dump returns the counters of all interfaces, in one round trip regardless of the interface count.
+// `ifIndex` > 0 requests that interface only
+static bool getDataNetlink(uint32_t ifIndex, uint32_t defaultRouteIfIndex, FFNetIOOptions* options, FFlist* result) {
+    FF_AUTO_CLOSE_FD int sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (sock < 0) {
+        return false;
     }
 
-    if (ffReadFileBufferRelative(dfd, "statistics/rx_errors", buffer)) {
-        counters->rxErrors = ffStrbufToUInt(buffer, 0);
+    struct {
+        struct nlmsghdr nlh;
+        struct ifinfomsg ifi;
+    } req = {
+        .nlh = {
+            .nlmsg_len = sizeof(req),
+            .nlmsg_type = RTM_GETLINK,
+            .nlmsg_flags = NLM_F_REQUEST | (ifIndex > 0 ? 0 : NLM_F_DUMP),
+            .nlmsg_seq = 1,
+        },
+        .ifi = {
+            .ifi_family = AF_UNSPEC,
+            .ifi_index = (int) ifIndex,
+        },
+    };
+    if (send(sock, &req, sizeof(req), 0) != (ssize_t) sizeof(req)) {
+        return false;
     }
 
-    if (ffReadFileBufferRelative(dfd, "statistics/tx_errors", buffer)) {
-        counters->txErrors = ffStrbufToUInt(buffer, 0);
+    uint8_t buffer[1024 * 32]; // Large enough for a dump message
+    while (true) {
+        ssize_t received = recv(sock, buffer, sizeof(buffer), MSG_TRUNC);
+        if (received <= 0 || received > (ssize_t) sizeof(buffer)) {
+            return false;
+        }
+
+        for (const struct nlmsghdr* nlh = (const struct nlmsghdr*) buffer;
+            NLMSG_OK(nlh, received);
+            nlh = NLMSG_NEXT(nlh, received)) {
+            if (nlh->nlmsg_seq != 1) {
+                continue;
+            }
+            if (nlh->nlmsg_type == NLMSG_DONE) {
+                return true;
+            }
+            if (nlh->nlmsg_type == NLMSG_ERROR) {
+                return false;
+            }
+            if (nlh->nlmsg_type == RTM_NEWLINK) {
+                parseLink(nlh, defaultRouteIfIndex, options, result);
+                if (ifIndex > 0) {
+                    return true;
+                }
+            }
+        }
     }
+}
 
-    if (ffReadFileBufferRelative(dfd, "statistics/rx_dropped", buffer)) {
-        counters->rxDrops = ffStrbufToUInt(buffer, 0);
+static bool tryGetDataNetlink(uint32_t ifIndex, uint32_t defaultRouteIfIndex, FFNetIOOptions* options, FFlist* result) {
+    uint32_t length = result->length;
+    if (getDataNetlink(ifIndex, defaultRouteIfIndex, options, result)) {
+        return true;
     }
 
-    if (ffReadFileBufferRelative(dfd, "statistics/tx_dropped", buffer)) {
-        counters->txDrops = ffStrbufToUInt(buffer, 0);
+    // Netlink may be blocked (e.g. by seccomp). Drop partial results, and read sysfs instead
+    for (uint32_t i = length; i < result->length; ++i) {
+        ffStrbufDestroy(&FF_LIST_GET(FFNetIOResult, *result, i)->name);
     }
+    result->length = length;
+    return false;
 }
 
 const char* ffNetIOGetIoCounters(FFlist* result, FFNetIOOptions* options) {
+    const FFNetifDefaultRouteResult* defaultRoute = ffNetifGetDefaultRouteV4();
+    const char* defaultRouteIfName = defaultRoute->ifName;
+
+    if (options->defaultRouteOnly) {
+        if (options->namePrefix.length && strncmp(defaultRouteIfName, options->namePrefix.chars, options->namePrefix.length) != 0) {
+            return NULL;
+        }
+
+        if (defaultRoute->ifIndex > 0 && tryGetDataNetlink(defaultRoute->ifIndex, defaultRoute->ifIndex, options, result)) {
+            return NULL;
+        }
+    } else if (tryGetDataNetlink(0, defaultRoute->ifIndex, options, result)) {
+        return NULL;
+    }
+
     FF_AUTO_CLOSE_DIR DIR* dirp = opendir("/sys/class/net");
     if (!dirp) {
         return "opendir(\"/sys/class/net\") == NULL";
@@ -63,14 +190,8 @@ const char* ffNetIOGetIoCounters(FFlist* result, FFNetIOOptions* options) {
 
     FF_STRBUF_AUTO_DESTROY buffer = ffStrbufCreate();
 
-    const char* defaultRouteIfName = ffNetifGetDefaultRouteV4()->ifName;
-
     if (options->defaultRouteOnly) {
-        if (options->namePrefix.length && strncmp(defaultRouteIfName, options->namePrefix.chars, options->namePrefix.length) != 0) {
-            return NULL;
-        }
-
-        getData(&buffer, defaultRouteIfName, true, dirfd(dirp), result);
+        getData(&buffer, defaultRouteIfName, true, result);
     } else {
         struct dirent* entry;
         while ((entry = readdir(dirp)) != NULL) {
@@ -83,7 +204,7 @@ const char* ffNetIOGetIoCounters(FFlist* result, FFNetIOOptions* options) {
                 continue;
             }
 
-            getData(&buffer, ifName, ffStrEquals(ifName, defaultRouteIfName), dirfd(dirp), result);
+            getData(&buffer, ifName, ffStrEquals(ifName, defaultRouteIfName), result);
         }
     }
 
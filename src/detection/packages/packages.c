@@ -1,6 +1,8 @@
 #include "packages.h"
 #include "common/io.h"
 #include "common/time.h"
+#include "common/thread.h"
+#include "detection/os/os.h"
 
 #include <inttypes.h>
 #include <stddef.h>
@@ -11,13 +13,69 @@
 
 void ffDetectPackagesImpl(FFPackagesResult* result, FFPackagesOptions* options);
 
-const char* ffDetectPackages(FFPackagesResult* result, FFPackagesOptions* options) {
+static void detectPackages(FFPackagesResult* result, FFPackagesOptions* options) {
     ffDetectPackagesImpl(result, options);
 
     for (uint32_t i = 0; i < offsetof(FFPackagesResult, all) / sizeof(uint32_t); ++i) {
         result->all += ((uint32_t*) result)[i];
     }
+}
+
+#ifdef FF_HAVE_THREADS
+// Package counting is pure file system work (plus `nix-store` invocations), which makes it safe to run it
+// in background while other modules are being printed. The result is consumed by the next `ffDetectPackages` call
+static struct {
+    FFThreadType thread;
+    FFPackagesOptions options; // Only detection related fields are valid
+    FFPackagesResult result;
+} prepared;
+
+static void detectPackagesPrepared(void) {
+    detectPackages(&prepared.result, &prepared.options);
+}
+FF_THREAD_ENTRY_DECL_WRAPPER_NOPARAM(detectPackagesPrepared)
+#endif
+
+void ffDetectPackagesAsync(FF_A_UNUSED FFPackagesOptions* options) {
+#ifdef FF_HAVE_THREADS
+    if (!instance.config.general.multithreading || prepared.thread) {
+        return; // Disabled or already prepared
+    }
+
+    #if !FF_PACKAGES_REMOVE_DISABLED
+    prepared.options.disabled = options->disabled;
+    #endif
+    prepared.result = (FFPackagesResult) {};
+    ffStrbufInit(&prepared.result.pacmanBranch);
+
+    // Initialize shared detection results in main thread to avoid data races
+    ffDetectOS();
+
+    prepared.thread = ffThreadCreate(detectPackagesPreparedThreadMain, NULL);
+#endif
+}
+
+const char* ffDetectPackages(FFPackagesResult* result, FFPackagesOptions* options) {
+#ifdef FF_HAVE_THREADS
+    if (prepared.thread) {
+        // Always join; the background detection uses the same caches as a synchronous one
+        ffThreadJoin(prepared.thread, 0);
+        prepared.thread = 0;
+
+        bool optionsMatch = true;
+    #if !FF_PACKAGES_REMOVE_DISABLED
+        optionsMatch = prepared.options.disabled == options->disabled;
+    #endif
+        if (optionsMatch) {
+            ffStrbufDestroy(&result->pacmanBranch);
+            *result = prepared.result;
+            return NULL;
+        }
+        ffStrbufDestroy(&prepared.result.pacmanBranch);
+    }
+#endif
 
+    detectPackages(result, options);
     return NULL;
 }
 
@@ -62,6 +62,8 @@ typedef struct FFPackagesResult {
     #define FF_PACKAGES_IS_ENABLED(options, pkgName) (!((options)->disabled & (FF_PACKAGES_FLAG_ ## pkgName ## _BIT)))
 #endif
 
+// Starts the detection in background. The caller must consume the result with `ffDetectPackages`
+void ffDetectPackagesAsync(FFPackagesOptions* options);
 const char* ffDetectPackages(FFPackagesResult* result, FFPackagesOptions* options);
 bool ffPackagesReadCache(FFstrbuf* cacheDir, FFstrbuf* cacheContent, const char* filePath, const char* packageId, uint32_t* result);
 bool ffPackagesWriteCache(FFstrbuf* cacheDir, FFstrbuf* cacheContent, uint32_t num_elements);
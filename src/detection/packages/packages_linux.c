@@ -4,8 +4,12 @@
 #include "common/properties.h"
 #include "common/settings.h"
 #include "common/strutil.h"
+#include "common/thread.h"
 #include "detection/os/os.h"
 
+#include <fcntl.h>
+#include <stddef.h>
+
 static uint32_t getNumElements(FFstrbuf* baseDir, const char* dirname, bool isdir) {
     uint32_t baseDirLength = baseDir->length;
     ffStrbufAppendS(baseDir, dirname);
@@ -15,19 +19,35 @@ static uint32_t getNumElements(FFstrbuf* baseDir, const char* dirname, bool isdi
 }
 
 static uint32_t getNumStringsImpl(const char* filename, const char* needle) {
-    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
-    if (!ffReadFileBuffer(filename, &content)) {
+    // Package databases (e.g. /var/lib/dpkg/status) can be several MiB large. Scan them in chunks instead of reading them whole.
+    // Not mmap: package managers may truncate the file while it's scanned, which raises SIGBUS on a mapping
+    FF_AUTO_CLOSE_FD int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
         return 0;
     }
 
-    uint32_t count = 0;
-    char* iter = content.chars;
+    enum { FF_PACKAGES_CHUNK_SIZE = 1 << 16 };
+    FF_AUTO_FREE char* buffer = malloc(FF_PACKAGES_CHUNK_SIZE);
     size_t needleLength = strlen(needle);
-    while ((iter = memmem(iter, content.length - (size_t) (iter - content.chars), needle, needleLength)) != NULL) {
-        ++count;
-        iter += needleLength;
-    }
+    size_t kept = 0; // Tail of the previous chunk, which may begin a match
+    uint32_t count = 0;
 
+    ssize_t bytesRead;
+    while ((bytesRead = ffReadFDData(fd, FF_PACKAGES_CHUNK_SIZE - kept, buffer + kept)) > 0) {
+        const char* iter = buffer;
+        const char* end = buffer + kept + (size_t) bytesRead;
+        const char* match;
+        while ((match = memmem(iter, (size_t) (end - iter), needle, needleLength)) != NULL) {
+            ++count;
+            iter = match + needleLength;
+        }
+
+        if ((size_t) (end - iter) >= needleLength) {
+            iter = end - (needleLength - 1);
+        }
+        kept = (size_t) (end - iter);
+        memmove(buffer, iter, kept);
+    }
     return count;
 }
 
@@ -273,14 +293,12 @@ static uint32_t getAMUser(void) {
     }
 
     // check if $XDG_CONFIG_HOME/appman/appman-config exists
-    FFstrbuf* baseDir = FF_LIST_FIRST(FFstrbuf, instance.state.platform.configDirs);
-    uint32_t baseLen = baseDir->length;
-    ffStrbufAppendS(baseDir, "appman/appman-config");
+    FF_STRBUF_AUTO_DESTROY configPath = ffStrbufCreateCopy(FF_LIST_FIRST(FFstrbuf, instance.state.platform.configDirs));
+    ffStrbufAppendS(&configPath, "appman/appman-config");
     FF_STRBUF_AUTO_DESTROY packagesPath = ffStrbufCreate();
-    if (ffReadFileBuffer(baseDir->chars, &packagesPath)) {
+    if (ffReadFileBuffer(configPath.chars, &packagesPath)) {
         ffStrbufTrimRightSpace(&packagesPath);
     }
-    ffStrbufSubstrBefore(baseDir, baseLen);
 
     return packagesPath.length > 0 ? getAMPackages(&packagesPath) : 0;
 }
@@ -483,7 +501,9 @@ static uint32_t getEmergePackages(FFstrbuf* baseDir, const char* dirname) {
     return result;
 }
 
-static void getPackageCounts(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
+// Package managers are grouped into tasks that only touch their own `baseDir` and `packageCounts`, so that they can run concurrently
+
+static void getPackageCountsDatabases(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
     if (FF_PACKAGES_IS_ENABLED(options, APK)) {
         packageCounts->apk += getNumStrings(baseDir, "/lib/apk/db/installed", "C:Q", "apk");
     }
@@ -493,22 +513,37 @@ static void getPackageCounts(FFstrbuf* baseDir, FFPackagesResult* packageCounts,
     if (FF_PACKAGES_IS_ENABLED(options, LPKG)) {
         packageCounts->lpkg += getNumStrings(baseDir, "/opt/Loc-OS-LPKG/installed-lpkg/Listinstalled-lpkg.list", "\n", "lpkg");
     }
+    if (FF_PACKAGES_IS_ENABLED(options, RPM)) {
+        // `Sigmd5` is the only table that doesn't contain the virtual `gpg-pubkey` package
+        packageCounts->rpm += getSQLite3Int(baseDir, "/var/lib/rpm/rpmdb.sqlite", "SELECT count(*) FROM Sigmd5", "rpm");
+    }
+    if (FF_PACKAGES_IS_ENABLED(options, XBPS)) {
+        packageCounts->xbps += getXBPS(baseDir, "/var/db/xbps");
+    }
+    if (FF_PACKAGES_IS_ENABLED(options, OPKG)) {
+        packageCounts->opkg += getNumStrings(baseDir, "/usr/lib/opkg/status", "Package:", "opkg"); // openwrt
+    }
+    if (FF_PACKAGES_IS_ENABLED(options, SORCERY)) {
+        packageCounts->sorcery += getNumStrings(baseDir, "/var/state/sorcery/packages", ":installed:", "sorcery");
+    }
+    if (FF_PACKAGES_IS_ENABLED(options, GUIX)) {
+        packageCounts->guixSystem += getGuixPackages(baseDir, "/run/current-system/profile");
+    }
+    if (FF_PACKAGES_IS_ENABLED(options, MOSS)) {
+        packageCounts->moss += getSQLite3Int(baseDir, "/.moss/db/state", "SELECT COUNT(*) FROM state_selections WHERE state_id = (SELECT MAX(id) FROM state)", "moss");
+    }
+}
+
+static void getPackageCountsDirectories(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
     if (FF_PACKAGES_IS_ENABLED(options, EMERGE)) {
         packageCounts->emerge += getEmergePackages(baseDir, "/var/db/pkg");
     }
     if (FF_PACKAGES_IS_ENABLED(options, EOPKG)) {
         packageCounts->eopkg += getNumElements(baseDir, "/var/lib/eopkg/package", true);
     }
-    if (FF_PACKAGES_IS_ENABLED(options, FLATPAK)) {
-        packageCounts->flatpakSystem += getFlatpakPackages(baseDir, "/var/lib");
-    }
     if (FF_PACKAGES_IS_ENABLED(options, KISS)) {
         packageCounts->kiss += getNumElements(baseDir, "/var/db/kiss/installed", true);
     }
-    if (FF_PACKAGES_IS_ENABLED(options, NIX)) {
-        packageCounts->nixDefault += ffPackagesGetNix(baseDir, "/nix/var/nix/profiles/default");
-        packageCounts->nixSystem += ffPackagesGetNix(baseDir, "/run/current-system");
-    }
     if (FF_PACKAGES_IS_ENABLED(options, PACMAN)) {
         packageCounts->pacman += getPacmanPackages(baseDir);
     }
@@ -521,16 +556,9 @@ static void getPackageCounts(FFstrbuf* baseDir, FFPackagesResult* packageCounts,
     if (FF_PACKAGES_IS_ENABLED(options, PORG)) {
         packageCounts->porg += getNumElements(baseDir, "/var/log/porg", false);
     }
-    if (FF_PACKAGES_IS_ENABLED(options, RPM)) {
-        // `Sigmd5` is the only table that doesn't contain the virtual `gpg-pubkey` package
-        packageCounts->rpm += getSQLite3Int(baseDir, "/var/lib/rpm/rpmdb.sqlite", "SELECT count(*) FROM Sigmd5", "rpm");
-    }
     if (FF_PACKAGES_IS_ENABLED(options, SNAP)) {
         packageCounts->snap += getSnap(baseDir);
     }
-    if (FF_PACKAGES_IS_ENABLED(options, XBPS)) {
-        packageCounts->xbps += getXBPS(baseDir, "/var/db/xbps");
-    }
     if (FF_PACKAGES_IS_ENABLED(options, BREW)) {
         packageCounts->brewCask += getNumElements(baseDir, "/home/linuxbrew/.linuxbrew/Caskroom", true);
         packageCounts->brew += getNumElements(baseDir, "/home/linuxbrew/.linuxbrew/Cellar", true);
@@ -538,17 +566,8 @@ static void getPackageCounts(FFstrbuf* baseDir, FFPackagesResult* packageCounts,
     if (FF_PACKAGES_IS_ENABLED(options, PALUDIS)) {
         packageCounts->paludis += countFilesRecursive(baseDir, "/var/db/paludis/repositories", "environment.bz2");
     }
-    if (FF_PACKAGES_IS_ENABLED(options, OPKG)) {
-        packageCounts->opkg += getNumStrings(baseDir, "/usr/lib/opkg/status", "Package:", "opkg"); // openwrt
-    }
     if (FF_PACKAGES_IS_ENABLED(options, AM)) {
-        packageCounts->amSystem = getAMSystem(baseDir);
-    }
-    if (FF_PACKAGES_IS_ENABLED(options, SORCERY)) {
-        packageCounts->sorcery += getNumStrings(baseDir, "/var/state/sorcery/packages", ":installed:", "sorcery");
-    }
-    if (FF_PACKAGES_IS_ENABLED(options, GUIX)) {
-        packageCounts->guixSystem += getGuixPackages(baseDir, "/run/current-system/profile");
+        packageCounts->amSystem += getAMSystem(baseDir);
     }
     if (FF_PACKAGES_IS_ENABLED(options, LINGLONG)) {
         packageCounts->linglong += getNumElements(baseDir, "/var/lib/linglong/layers", true);
@@ -562,28 +581,131 @@ static void getPackageCounts(FFstrbuf* baseDir, FFPackagesResult* packageCounts,
     if (FF_PACKAGES_IS_ENABLED(options, PKGSRC)) {
         packageCounts->pkgsrc += getNumElements(baseDir, "/usr/pkg/pkgdb", DT_DIR);
     }
-    if (FF_PACKAGES_IS_ENABLED(options, MOSS)) {
-        packageCounts->moss += getSQLite3Int(baseDir, "/.moss/db/state", "SELECT COUNT(*) FROM state_selections WHERE state_id = (SELECT MAX(id) FROM state)", "moss");
-    }
     if (FF_PACKAGES_IS_ENABLED(options, CARDS)) {
         packageCounts->cards += getNumElements(baseDir, "/var/lib/pkg/DB", true);
     }
 }
 
-static void getPackageCountsRegular(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
-    getPackageCounts(baseDir, packageCounts, options);
+static void getPackageCountsFlatpak(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
+    if (FF_PACKAGES_IS_ENABLED(options, FLATPAK)) {
+        packageCounts->flatpakSystem += getFlatpakPackages(baseDir, "/var/lib");
+    }
+}
 
-    if (FF_PACKAGES_IS_ENABLED(options, PACMAN)) {
-        uint32_t baseDirLength = baseDir->length;
-        ffStrbufAppendS(baseDir, FASTFETCH_TARGET_DIR_ETC "/pacman-mirrors.conf");
-        if (ffParsePropFile(baseDir->chars, "Branch =", &packageCounts->pacmanBranch) && packageCounts->pacmanBranch.length == 0) {
-            ffStrbufAppendS(&packageCounts->pacmanBranch, "stable");
+static void getPackageCountsNix(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
+    if (FF_PACKAGES_IS_ENABLED(options, NIX)) {
+        packageCounts->nixDefault += ffPackagesGetNix(baseDir, "/nix/var/nix/profiles/default");
+        packageCounts->nixSystem += ffPackagesGetNix(baseDir, "/run/current-system");
+    }
+}
+
+static uint32_t getInstallReleasePackages(FFstrbuf* baseDir) {
+    uint32_t result = 0;
+
+    uint32_t baseDirLength = baseDir->length;
+    ffStrbufAppendS(baseDir, ".config/install_release/state.json");
+    if (ffPathExists(baseDir->chars, FF_PATHTYPE_ANY)) {
+        yyjson_doc* doc = yyjson_read_file(baseDir->chars, YYJSON_READ_NOFLAG, NULL, NULL);
+        if (doc != NULL) {
+            yyjson_val* root = yyjson_doc_get_root(doc);
+            if (yyjson_is_obj(root)) {
+                result = (uint32_t) yyjson_obj_size(root);
+            }
+            yyjson_doc_free(doc);
         }
-        ffStrbufSubstrBefore(baseDir, baseDirLength);
     }
+    ffStrbufSubstrBefore(baseDir, baseDirLength);
+    return result;
 }
 
-static void getPackageCountsBedrock(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
+
+static void getUserPackageCounts(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
+    if (FF_PACKAGES_IS_ENABLED(options, GUIX)) {
+        packageCounts->guixUser += getGuixPackages(baseDir, ".guix-profile");
+        packageCounts->guixHome += getGuixPackages(baseDir, ".guix-home/profile");
+    }
+
+    if (FF_PACKAGES_IS_ENABLED(options, FLATPAK)) {
+        packageCounts->flatpakUser += getFlatpakPackages(baseDir, "/.local/share");
+    }
+
+    if (FF_PACKAGES_IS_ENABLED(options, AM)) {
+        packageCounts->amUser += getAMUser();
+    }
+
+    if (FF_PACKAGES_IS_ENABLED(options, SOAR)) {
+        packageCounts->soar += getSQLite3Int(baseDir, ".local/share/soar/db/soar.db", "SELECT COUNT(DISTINCT pkg_id || pkg_name) FROM packages WHERE is_installed = true", "soar");
+    }
+
+    if (FF_PACKAGES_IS_ENABLED(options, APPIMAGE)) {
+        packageCounts->appimage += getNumElementsBySuffix(baseDir, "/AppImages", ".appimage");
+        packageCounts->appimage += getNumElementsBySuffix(baseDir, "/Applications", ".appimage");
+    }
+
+    if (FF_PACKAGES_IS_ENABLED(options, INSTALLRELEASE)) {
+        packageCounts->installrelease += getInstallReleasePackages(baseDir);
+    }
+}
+
+static void getUserPackageCountsNix(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options) {
+    if (!FF_PACKAGES_IS_ENABLED(options, NIX)) {
+        return;
+    }
+
+    // Count packages from $HOME/.nix-profile
+    packageCounts->nixUser += ffPackagesGetNix(baseDir, ".nix-profile");
+
+    // Check in $XDG_STATE_HOME/nix/profile
+    FF_STRBUF_AUTO_DESTROY stateHome = ffStrbufCreate();
+    const char* stateHomeEnv = getenv("XDG_STATE_HOME");
+    if (ffStrSet(stateHomeEnv)) {
+        ffStrbufSetS(&stateHome, stateHomeEnv);
+        ffStrbufEnsureEndsWithC(&stateHome, '/');
+    } else {
+        ffStrbufSet(&stateHome, &instance.state.platform.homeDir);
+        ffStrbufAppendS(&stateHome, ".local/state/");
+    }
+    packageCounts->nixUser += ffPackagesGetNix(&stateHome, "nix/profile");
+
+    // Check in /etc/profiles/per-user/$USER
+    FF_STRBUF_AUTO_DESTROY userPkgsDir = ffStrbufCreateStatic("/etc/profiles/per-user/");
+    packageCounts->nixUser += ffPackagesGetNix(&userPkgsDir, instance.state.platform.userName.chars);
+}
+
+typedef void (*PackageCountsFunc)(FFstrbuf* baseDir, FFPackagesResult* packageCounts, FFPackagesOptions* options);
+
+typedef struct PackageCountsTask {
+    PackageCountsFunc func;
+    FFstrbuf baseDir;
+    FFPackagesOptions* options;
+    FFPackagesResult packageCounts; // Only counters are used
+#ifdef FF_HAVE_THREADS
+    FFThreadType thread;
+#endif
+} PackageCountsTask;
+
+static void runPackageCountsTask(PackageCountsTask* task) {
+    task->func(&task->baseDir, &task->packageCounts, task->options);
+}
+FF_THREAD_ENTRY_DECL_WRAPPER(runPackageCountsTask, PackageCountsTask*)
+
+static void addPackageCountsTask(FFlist* tasks, PackageCountsFunc func, const FFstrbuf* baseDir, FFPackagesOptions* options) {
+    PackageCountsTask* task = FF_LIST_ADD(PackageCountsTask, *tasks);
+    *task = (PackageCountsTask) {
+        .func = func,
+        .options = options,
+    };
+    ffStrbufInitCopy(&task->baseDir, baseDir);
+}
+
+static void addPackageCountsTasks(FFlist* tasks, const FFstrbuf* baseDir, FFPackagesOptions* options) {
+    addPackageCountsTask(tasks, getPackageCountsDatabases, baseDir, options);
+    addPackageCountsTask(tasks, getPackageCountsDirectories, baseDir, options);
+    addPackageCountsTask(tasks, getPackageCountsFlatpak, baseDir, options);
+    addPackageCountsTask(tasks, getPackageCountsNix, baseDir, options);
+}
+
+static void addPackageCountsTasksBedrock(FFlist* tasks, FFstrbuf* baseDir, FFPackagesOptions* options) {
     uint32_t baseDirLength = baseDir->length;
 
     ffStrbufAppendS(baseDir, "/bedrock/strata");
@@ -607,40 +729,63 @@ static void getPackageCountsBedrock(FFstrbuf* baseDir, FFPackagesResult* package
         }
 
         ffStrbufAppendS(baseDir, entry->d_name);
-        getPackageCounts(baseDir, packageCounts, options);
+        addPackageCountsTasks(tasks, baseDir, options);
         ffStrbufSubstrBefore(baseDir, baseDirLength2);
     }
 
     ffStrbufSubstrBefore(baseDir, baseDirLength);
 }
 
-static uint32_t getInstallReleasePackages(FFstrbuf* baseDir) {
-    uint32_t result = 0;
+static void runPackageCountsTasks(FFlist* tasks, FFPackagesResult* result) {
+    // Start all tasks before joining any of them. `tasks` must not grow from now on
+#ifdef FF_HAVE_THREADS
+    if (instance.config.general.multithreading) {
+        FF_LIST_FOR_EACH (PackageCountsTask, task, *tasks) {
+            task->thread = ffThreadCreate(runPackageCountsTaskThreadMain, task);
+        }
+    }
+#endif
 
-    uint32_t baseDirLength = baseDir->length;
-    ffStrbufAppendS(baseDir, ".config/install_release/state.json");
-    if (ffPathExists(baseDir->chars, FF_PATHTYPE_ANY)) {
-        yyjson_doc* doc = yyjson_read_file(baseDir->chars, YYJSON_READ_NOFLAG, NULL, NULL);
-        if (doc != NULL) {
-            yyjson_val* root = yyjson_doc_get_root(doc);
-            if (yyjson_is_obj(root)) {
-                result = (uint32_t) yyjson_obj_size(root);
-            }
-            yyjson_doc_free(doc);
+    FF_LIST_FOR_EACH (PackageCountsTask, task, *tasks) {
+#ifdef FF_HAVE_THREADS
+        if (task->thread) {
+            ffThreadJoin(task->thread, 0);
+        } else
+#endif
+        {
+            runPackageCountsTask(task); // Threads disabled or failed to start
+        }
+
+        for (uint32_t i = 0; i < offsetof(FFPackagesResult, all) / sizeof(uint32_t); ++i) {
+            ((uint32_t*) result)[i] += ((uint32_t*) &task->packageCounts)[i];
         }
+        ffStrbufDestroy(&task->baseDir);
     }
-    ffStrbufSubstrBefore(baseDir, baseDirLength);
-    return result;
 }
 
 void ffDetectPackagesImpl(FFPackagesResult* result, FFPackagesOptions* options) {
     FF_STRBUF_AUTO_DESTROY baseDir = ffStrbufCreateA(512);
     ffStrbufAppendS(&baseDir, FASTFETCH_TARGET_DIR_ROOT);
 
-    if (ffStrbufIgnCaseEqualS(&ffDetectOS()->id, "bedrock")) {
-        getPackageCountsBedrock(&baseDir, result, options);
+    FF_LIST_AUTO_DESTROY tasks = ffListCreate();
+
+    bool bedrock = ffStrbufIgnCaseEqualS(&ffDetectOS()->id, "bedrock");
+    if (bedrock) {
+        addPackageCountsTasksBedrock(&tasks, &baseDir, options);
     } else {
-        getPackageCountsRegular(&baseDir, result, options);
+        addPackageCountsTasks(&tasks, &baseDir, options);
+    }
+
+    addPackageCountsTask(&tasks, getUserPackageCounts, &instance.state.platform.homeDir, options);
+    addPackageCountsTask(&tasks, getUserPackageCountsNix, &instance.state.platform.homeDir, options);
+
+    runPackageCountsTasks(&tasks, result);
+
+    if (!bedrock && FF_PACKAGES_IS_ENABLED(options, PACMAN)) {
+        ffStrbufAppendS(&baseDir, FASTFETCH_TARGET_DIR_ETC "/pacman-mirrors.conf");
+        if (ffParsePropFile(baseDir.chars, "Branch =", &result->pacmanBranch) && result->pacmanBranch.length == 0) {
+            ffStrbufAppendS(&result->pacmanBranch, "stable");
+        }
     }
 
 // If SQL failed, we can still try with librpm.
@@ -651,52 +796,4 @@ void ffDetectPackagesImpl(FFPackagesResult* result, FFPackagesOptions* options)
         result->rpm = getRpmFromLibrpm();
     }
 #endif
-
-    ffStrbufSet(&baseDir, &instance.state.platform.homeDir);
-    if (FF_PACKAGES_IS_ENABLED(options, NIX)) {
-        // Count packages from $HOME/.nix-profile
-        result->nixUser += ffPackagesGetNix(&baseDir, ".nix-profile");
-
-        // Check in $XDG_STATE_HOME/nix/profile
-        FF_STRBUF_AUTO_DESTROY stateHome = ffStrbufCreate();
-        const char* stateHomeEnv = getenv("XDG_STATE_HOME");
-        if (ffStrSet(stateHomeEnv)) {
-            ffStrbufSetS(&stateHome, stateHomeEnv);
-            ffStrbufEnsureEndsWithC(&stateHome, '/');
-        } else {
-            ffStrbufSet(&stateHome, &instance.state.platform.homeDir);
-            ffStrbufAppendS(&stateHome, ".local/state/");
-        }
-        result->nixUser += ffPackagesGetNix(&stateHome, "nix/profile");
-
-        // Check in /etc/profiles/per-user/$USER
-        FF_STRBUF_AUTO_DESTROY userPkgsDir = ffStrbufCreateStatic("/etc/profiles/per-user/");
-        result->nixUser += ffPackagesGetNix(&userPkgsDir, instance.state.platform.userName.chars);
-    }
-
-    if (FF_PACKAGES_IS_ENABLED(options, GUIX)) {
-        result->guixUser += getGuixPackages(&baseDir, ".guix-profile");
-        result->guixHome += getGuixPackages(&baseDir, ".guix-home/profile");
-    }
-
-    if (FF_PACKAGES_IS_ENABLED(options, FLATPAK)) {
-        result->flatpakUser = getFlatpakPackages(&baseDir, "/.local/share");
-    }
-
-    if (FF_PACKAGES_IS_ENABLED(options, AM)) {
-        result->amUser = getAMUser();
-    }
-
-    if (FF_PACKAGES_IS_ENABLED(options, SOAR)) {
-        result->soar += getSQLite3Int(&baseDir, ".local/share/soar/db/soar.db", "SELECT COUNT(DISTINCT pkg_id || pkg_name) FROM packages WHERE is_installed = true", "soar");
-    }
-
-    if (FF_PACKAGES_IS_ENABLED(options, APPIMAGE)) {
-        result->appimage += getNumElementsBySuffix(&baseDir, "/AppImages", ".appimage");
-        result->appimage += getNumElementsBySuffix(&baseDir, "/Applications", ".appimage");
-    }
-
-    if (FF_PACKAGES_IS_ENABLED(options, INSTALLRELEASE)) {
-        result->installrelease = getInstallReleasePackages(&baseDir);
-    }
 }
@@ -1,8 +1,12 @@
 #include "packages.h"
 #include "common/io.h"
 #include "common/processing.h"
+#include "common/settings.h"
 #include "common/strutil.h"
 
+#include <limits.h>
+#include <stdlib.h>
+
 static bool isValidNixPkg(FFstrbuf* pkg) {
     if (!ffPathExists(pkg->chars, FF_PATHTYPE_DIRECTORY)) {
         return false;
@@ -85,6 +89,44 @@ static bool writeNixCache(FFstrbuf* cacheDir, FFstrbuf* hash, uint32_t count) {
     return ffWriteFileBuffer(cacheDir->chars, &cacheContent);
 }
 
+static uint32_t countNixPackages(FFstrbuf* output) {
+    uint32_t count = 0;
+    uint32_t lineLength = 0;
+    for (uint32_t i = 0; i < output->length; i++) {
+        if (output->chars[i] != '\n') {
+            lineLength++;
+            continue;
+        }
+
+        output->chars[i] = '\0';
+        FFstrbuf line = {
+            .allocated = 0,
+            .length = lineLength,
+            .chars = output->chars + i - lineLength
+        };
+        if (isValidNixPkg(&line)) {
+            count++;
+        }
+        lineLength = 0;
+    }
+    return count;
+}
+
+static bool getNixRequisitesFromDb(const char* storePath, FFstrbuf* output) {
+    if (strchr(storePath, '\'')) {
+        return false; // Never happens for valid store paths
+    }
+
+    // Same as `nix-store --query --requisites`, reading the database directly
+    FF_STRBUF_AUTO_DESTROY query = ffStrbufCreateF(
+        "WITH RECURSIVE closure(id) AS ("
+            "SELECT id FROM ValidPaths WHERE path = '%s' "
+            "UNION SELECT Refs.reference FROM Refs JOIN closure ON Refs.referrer = closure.id"
+        ") SELECT group_concat(path, char(10)) || char(10) FROM ValidPaths WHERE id IN closure",
+        storePath);
+    return ffSettingsGetSQLite3String("/nix/var/nix/db/db.sqlite", query.chars, output) && output->length > 1;
+}
+
 static uint32_t getNixPackagesImpl(char* path) {
     // Nix detection is kinda slow, so we only do it if the dir exists
     if (!ffPathExists(path, FF_PATHTYPE_DIRECTORY)) {
@@ -96,46 +138,36 @@ static uint32_t getNixPackagesImpl(char* path) {
     ffStrbufAppendS(&cacheDir, "fastfetch/packages/nix");
     ffStrbufAppendS(&cacheDir, path);
 
-    // Check the hash first to determine if we need to recompute the count
-    FF_STRBUF_AUTO_DESTROY hash = ffStrbufCreateA(64);
+    // Profiles are symlink chains ending in an immutable store path, which identifies the closure.
+    // Use it to validate the cache instead of querying `nix-store --query --hash`
+    FF_STRBUF_AUTO_DESTROY hash = ffStrbufCreateA(PATH_MAX);
+    if (!realpath(path, hash.chars)) {
+        return 0;
+    }
+    ffStrbufRecalculateLength(&hash);
+
     FF_STRBUF_AUTO_DESTROY cacheHash = ffStrbufCreateA(64);
     uint32_t count = 0;
 
-    ffProcessAppendStdOut(&hash, (char* const[]) { "nix-store", "--query", "--hash", path, NULL });
-
     if (checkNixCache(&cacheDir, &cacheHash, &count) && ffStrbufEqual(&hash, &cacheHash)) {
         return count;
     }
 
     // Cache is invalid, recompute the count
-    count = 0;
 
     // Implementation based on bash script from here:
     // https://github.com/fastfetch-cli/fastfetch/issues/195#issuecomment-1191748222
 
     FF_STRBUF_AUTO_DESTROY output = ffStrbufCreateA(1024);
 
-    ffProcessAppendStdOut(&output, (char* const[]) { "nix-store", "--query", "--requisites", path, NULL });
-
-    uint32_t lineLength = 0;
-    for (uint32_t i = 0; i < output.length; i++) {
-        if (output.chars[i] != '\n') {
-            lineLength++;
-            continue;
-        }
-
-        output.chars[i] = '\0';
-        FFstrbuf line = {
-            .allocated = 0,
-            .length = lineLength,
-            .chars = output.chars + i - lineLength
-        };
-        if (isValidNixPkg(&line)) {
-            count++;
-        }
-        lineLength = 0;
+    if (!getNixRequisitesFromDb(hash.chars, &output)) {
+        // SQLite is unavailable or the database is not readable (e.g. WAL files owned by root)
+        ffStrbufClear(&output);
+        ffProcessAppendStdOut(&output, (char* const[]) { "nix-store", "--query", "--requisites", path, NULL });
     }
 
+    count = countNixPackages(&output);
+
     writeNixCache(&cacheDir, &hash, count);
     return count;
 }
@@ -2,4 +2,9 @@
 
 #include "fastfetch.h"
 
-const char* ffDetectProcesses(uint32_t* result);
+typedef struct FFProcessesResult {
+    uint32_t processes;
+    uint32_t threads; // 0 if unknown
+} FFProcessesResult;
+
+const char* ffDetectProcesses(FFProcessesResult* result);
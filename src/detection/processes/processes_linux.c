@@ -3,7 +3,23 @@
 #include "common/io.h"
 #include "common/strutil.h"
 
-const char* ffDetectProcesses(uint32_t* result) {
+#if __linux__ || __GNU__
+    #include "common/proctable.h"
+
+const char* ffDetectProcesses(FFProcessesResult* result) {
+    const FFProcTable* table = ffProcTableGet();
+    if (table == NULL) {
+        return "Failed to read processes from /proc";
+    }
+
+    result->processes = table->entries.length;
+    result->threads = table->threads;
+    return NULL;
+}
+
+#else
+
+const char* ffDetectProcesses(FFProcessesResult* result) {
     FF_AUTO_CLOSE_DIR DIR* dir = opendir("/proc");
     if (dir == NULL) {
         return "opendir(\"/proc\") failed";
@@ -14,14 +30,16 @@ const char* ffDetectProcesses(uint32_t* result) {
     struct dirent* entry;
     while ((entry = readdir(dir)) != NULL) {
         if (
-#ifdef _DIRENT_HAVE_D_TYPE
+    #ifdef _DIRENT_HAVE_D_TYPE
             (entry->d_type == DT_DIR || entry->d_type == DT_UNKNOWN) &&
-#endif
+    #endif
             ffCharIsDigit(entry->d_name[0]))
             ++num;
     }
 
-    *result = num;
+    result->processes = num;
 
     return NULL;
 }
+
+#endif
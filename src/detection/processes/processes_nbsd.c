@@ -2,7 +2,7 @@
 
 #include <sys/sysctl.h>
 
-const char* ffDetectProcesses(uint32_t* result) {
+const char* ffDetectProcesses(FFProcessesResult* result) {
     int request[] = { CTL_KERN, KERN_PROC2, KERN_PROC_ALL, -1, sizeof(struct kinfo_proc2), 0 };
     size_t length = 0;
 
@@ -10,6 +10,6 @@ const char* ffDetectProcesses(uint32_t* result) {
         return "sysctl({CTL_KERN, KERN_PROC2, KERN_PROC_ALL}) failed";
     }
 
-    *result = (uint32_t) (length / sizeof(struct kinfo_proc2));
+    result->processes = (uint32_t) (length / sizeof(struct kinfo_proc2));
     return NULL;
 }
@@ -1,5 +1,5 @@
 #include "processes.h"
 
-const char* ffDetectProcesses(uint32_t* result) {
+const char* ffDetectProcesses(FF_A_UNUSED FFProcessesResult* result) {
     return "Not supported on this platform";
 }
@@ -4,7 +4,7 @@
 #include <ntstatus.h>
 #include <winternl.h>
 
-const char* ffDetectProcesses(uint32_t* result) {
+const char* ffDetectProcesses(FFProcessesResult* result) {
     SYSTEM_PROCESS_INFORMATION* FF_AUTO_FREE pstart = NULL;
 
     // Multiple attempts in case processes change while
@@ -25,9 +25,12 @@ const char* ffDetectProcesses(uint32_t* result) {
         }
     }
 
-    *result = 1; // Init with 1 because we test for ptr->NextEntryOffset
-    for (SYSTEM_PROCESS_INFORMATION* ptr = pstart; ptr->NextEntryOffset; ptr = (SYSTEM_PROCESS_INFORMATION*) ((uint8_t*) ptr + ptr->NextEntryOffset)) {
-        ++*result;
+    for (SYSTEM_PROCESS_INFORMATION* ptr = pstart;; ptr = (SYSTEM_PROCESS_INFORMATION*) ((uint8_t*) ptr + ptr->NextEntryOffset)) {
+        ++result->processes;
+        result->threads += ptr->NumberOfThreads;
+        if (!ptr->NextEntryOffset) {
+            break;
+        }
     }
 
     return NULL;
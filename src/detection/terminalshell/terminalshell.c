@@ -94,10 +94,22 @@ static bool getShellVersionFish(FFstrbuf* exe, FFstrbuf* version) {
     return true;
 }
 
+static bool versionFromEnv;
+
+// Versions read from the environment describe the current session, not the binary on disk
+static const char* getVersionEnv(const char* name) {
+    const char* env = getenv(name);
+    if (!env || !*env) {
+        return NULL;
+    }
+    versionFromEnv = true;
+    return env;
+}
+
 static bool getShellVersionPwsh(FFstrbuf* exe, FFstrbuf* version) {
     // Requires manually setting $POWERSHELL_VERSION
     // $env:POWERSHELL_VERSION = $PSVersionTable.PSVersion.ToString(); fastfetch.exe
-    const char* env = getenv("POWERSHELL_VERSION");
+    const char* env = getVersionEnv("POWERSHELL_VERSION");
     if (env) {
         ffStrbufSetS(version, env);
         return true;
@@ -161,7 +173,7 @@ static bool getShellVersionOils(FFstrbuf* exe, FFstrbuf* version) {
 }
 
 static bool getShellVersionNushell(FFstrbuf* exe, FFstrbuf* version) {
-    ffStrbufSetS(version, getenv("NU_VERSION"));
+    ffStrbufSetS(version, getVersionEnv("NU_VERSION"));
     if (version->length) {
         return true;
     }
@@ -202,7 +214,7 @@ static bool getShellVersionAsh(FFstrbuf* exe, FFstrbuf* version) {
 }
 
 static bool getShellVersionXonsh(FF_A_UNUSED FFstrbuf* exe, FFstrbuf* version) {
-    ffStrbufSetS(version, getenv("XONSH_VERSION"));
+    ffStrbufSetS(version, getVersionEnv("XONSH_VERSION"));
     if (version->length) {
         return true;
     }
@@ -242,7 +254,7 @@ static bool getShellVersionZsh(FFstrbuf* exe, FFstrbuf* version) {
 
 #ifdef _WIN32
 static bool getShellVersionWinPowerShell(FFstrbuf* exe, FFstrbuf* version) {
-    const char* env = getenv("POWERSHELL_VERSION");
+    const char* env = getVersionEnv("POWERSHELL_VERSION");
     if (env) {
         ffStrbufSetS(version, env);
         return true;
@@ -253,6 +265,8 @@ static bool getShellVersionWinPowerShell(FFstrbuf* exe, FFstrbuf* version) {
 #endif
 
 bool fftsGetShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* version) {
+    versionFromEnv = false;
+
     if (ffStrEqualsIgnCase(exeName, "sh")) { // #849
         return false;
     }
@@ -309,7 +323,7 @@ bool fftsGetShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* version)
 }
 
 FF_A_UNUSED static bool getTerminalVersionTermux(FFstrbuf* version) {
-    ffStrbufSetS(version, getenv("TERMUX_VERSION"));
+    ffStrbufSetS(version, getVersionEnv("TERMUX_VERSION"));
     return version->length > 0;
 }
 
@@ -367,7 +381,7 @@ FF_A_UNUSED static bool getTerminalVersionKgx(FFstrbuf* version) {
 }
 
 FF_A_UNUSED static bool getTerminalVersionKonsole(FFstrbuf* exe, FFstrbuf* version) {
-    const char* konsoleVersion = getenv("KONSOLE_VERSION");
+    const char* konsoleVersion = getVersionEnv("KONSOLE_VERSION");
     if (konsoleVersion) {
         // 221201
         long major = strtol(konsoleVersion, NULL, 10);
@@ -432,7 +446,7 @@ FF_A_UNUSED static bool getTerminalVersionCockpit(FFstrbuf* exe, FFstrbuf* versi
 }
 
 FF_A_UNUSED static bool getTerminalVersionXterm(FFstrbuf* exe, FFstrbuf* version) {
-    ffStrbufSetS(version, getenv("XTERM_VERSION"));
+    ffStrbufSetS(version, getVersionEnv("XTERM_VERSION"));
     if (!version->length) {
         if (ffProcessAppendStdOut(version, (char* const[]) { exe->chars, "-v", NULL })) {
             return false;
@@ -534,7 +548,7 @@ FF_A_UNUSED static bool getTerminalVersionKmscon(FFstrbuf* exe, FFstrbuf* versio
 }
 
 static bool getTerminalVersionContour(FFstrbuf* exe, FFstrbuf* version) {
-    const char* env = getenv("TERMINAL_VERSION_STRING");
+    const char* env = getVersionEnv("TERMINAL_VERSION_STRING");
     if (env) {
         ffStrbufAppendS(version, env);
         return true;
@@ -759,7 +773,7 @@ static bool getTerminalVersionWindowsTerminal(FFstrbuf* exe, FFstrbuf* version)
 }
 
 static bool getTerminalVersionConEmu(FFstrbuf* exe, FFstrbuf* version) {
-    ffStrbufSetS(version, getenv("ConEmuBuild"));
+    ffStrbufSetS(version, getVersionEnv("ConEmuBuild"));
 
     if (version->length) {
         return true;
@@ -771,6 +785,8 @@ static bool getTerminalVersionConEmu(FFstrbuf* exe, FFstrbuf* version) {
 #endif
 
 bool fftsGetTerminalVersion(FFstrbuf* processName, FF_A_UNUSED FFstrbuf* exe, FFstrbuf* version) {
+    versionFromEnv = false;
+
 #ifdef __ANDROID__
 
     if (ffStrbufEqualS(processName, "com.termux")) {
@@ -945,6 +961,7 @@ bool fftsGetTerminalVersion(FFstrbuf* processName, FF_A_UNUSED FFstrbuf* exe, FF
 #endif
                 false) {
                 ffStrbufSetS(version, termProgramVersion);
+                versionFromEnv = true;
                 return true;
             }
         }
@@ -958,6 +975,7 @@ bool fftsGetTerminalVersion(FFstrbuf* processName, FF_A_UNUSED FFstrbuf* exe, FF
                 (ffStrEquals(termProgram, "vscode") && ffStrbufStartsWithIgnCaseS(processName, "code")) ||
                 (ffStrStartsWith(termProgram, "iTerm") && ffStrbufStartsWithIgnCaseS(processName, "iTermServer-"))) {
                 ffStrbufSetS(version, termProgramVersion);
+                versionFromEnv = true;
                 return true;
             }
         }
@@ -985,3 +1003,7 @@ bool fftsGetTerminalVersion(FFstrbuf* processName, FF_A_UNUSED FFstrbuf* exe, FF
 
 #endif
 }
+
+bool fftsIsVersionFromEnv(void) {
+    return versionFromEnv;
+}
@@ -33,3 +33,5 @@ const FFTerminalResult* ffDetectTerminal();
 
 bool fftsGetShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* version);
 bool fftsGetTerminalVersion(FFstrbuf* processName, FFstrbuf* exe, FFstrbuf* version);
+// Whether the last fftsGet*Version call took the version from an environment variable
+bool fftsIsVersionFromEnv(void);
@@ -2,6 +2,7 @@
 #include "common/io.h"
 #include "common/parsing.h"
 #include "common/processing.h"
+#include "common/resultcache.h"
 #include "common/thread.h"
 #include "common/strutil.h"
 
@@ -407,7 +408,13 @@ const FFShellResult* ffDetectShell() {
     if (result.processName.length > 0) {
         setShellInfoDetails(&result);
         if (instance.config.general.detectVersion) {
-            fftsGetShellVersion(result.exePath.length > 0 ? &result.exePath : &result.exe, result.exeName, &result.version);
+            FFstrbuf* exe = result.exePath.length > 0 ? &result.exePath : &result.exe;
+            if (!ffResultCacheGetExeVersion("Shell", result.exeName, exe->chars, &result.version)) {
+                fftsGetShellVersion(exe, result.exeName, &result.version);
+                if (!fftsIsVersionFromEnv()) {
+                    ffResultCacheSetExeVersion("Shell", result.exeName, exe->chars, &result.version);
+                }
+            }
         }
     }
 
@@ -441,7 +448,13 @@ const FFTerminalResult* ffDetectTerminal() {
     if (result.processName.length > 0) {
         setTerminalInfoDetails(&result);
         if (instance.config.general.detectVersion) {
-            fftsGetTerminalVersion(&result.processName, result.exePath.length > 0 ? &result.exePath : &result.exe, &result.version);
+            FFstrbuf* exe = result.exePath.length > 0 ? &result.exePath : &result.exe;
+            if (!ffResultCacheGetExeVersion("Terminal", result.processName.chars, exe->chars, &result.version)) {
+                fftsGetTerminalVersion(&result.processName, exe, &result.version);
+                if (!fftsIsVersionFromEnv()) {
+                    ffResultCacheSetExeVersion("Terminal", result.processName.chars, exe->chars, &result.version);
+                }
+            }
         }
     }
 
@@ -4,6 +4,7 @@
 #include "common/io.h"
 #include "common/binary.h"
 #include "common/path.h"
+#include "common/resultcache.h"
 #include "common/strutil.h"
 #include "common/debug.h"
 
@@ -300,11 +301,7 @@ static const char* getOpenbox(FFstrbuf* result) {
     return "Failed to run command `openbox --version`";
 }
 
-const char* ffDetectWMVersion(const FFstrbuf* wmName, FFstrbuf* result, FF_A_UNUSED FFWMOptions* options) {
-    if (!wmName) {
-        return "No WM detected";
-    }
-
+static const char* detectWMVersion(const FFstrbuf* wmName, FFstrbuf* result) {
 #if !__ANDROID__
     // Wayland compositors
     if (ffStrbufIgnCaseEqualS(wmName, "Hyprland")) {
@@ -353,3 +350,22 @@ const char* ffDetectWMVersion(const FFstrbuf* wmName, FFstrbuf* result, FF_A_UNU
 
     return "Unsupported WM";
 }
+
+const char* ffDetectWMVersion(const FFstrbuf* wmName, FFstrbuf* result, FF_A_UNUSED FFWMOptions* options) {
+    if (!wmName) {
+        return "No WM detected";
+    }
+
+    // Cache the version by the WM binary, if it is named after the WM
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    bool cacheable = ffFindExecutableInPath(wmName->chars, &path) == NULL;
+    if (cacheable && ffResultCacheGetExeVersion("WM", wmName->chars, path.chars, result)) {
+        return NULL;
+    }
+
+    const char* error = detectWMVersion(wmName, result);
+    if (!error && cacheable) {
+        ffResultCacheSetExeVersion("WM", wmName->chars, path.chars, result);
+    }
+    return error;
+}
@@ -3,10 +3,13 @@
 #include "detection/version/version.h"
 #include "logo/logo.h"
 #include "common/commandoption.h"
+#include "common/frame.h"
 #include "common/init.h"
 #include "common/io.h"
 #include "common/jsonconfig.h"
+#include "common/sampler.h"
 #include "common/time.h"
+#include "common/trace.h"
 #include "common/strutil.h"
 #include "common/mallocHelper.h"
 #include "fastfetch_datatext.h"
@@ -378,6 +381,7 @@ static void listModules(bool pretty) {
 
 static bool parseJsoncFile(FFdata* data, const char* path, yyjson_read_flag flg) {
     assert(!data->configDoc);
+    FF_TRACE_SPAN(span, "config", path ? path : "stdin");
 
     {
         yyjson_read_err error;
@@ -670,6 +674,15 @@ static void parseCommand(FFdata* data, char* key, char* value) {
         }
     } else if (ffStrEqualsIgnCase(key, "--dynamic-interval")) {
         instance.state.dynamicInterval = ffOptionParseUInt32(key, value); // seconds to milliseconds
+    } else if (ffStrEqualsIgnCase(key, "--stat-trace")) {
+        if (!value) {
+            fprintf(stderr, "Error: usage: %s <file>\n", key);
+            exit(477);
+        }
+        // Already enabled in `main`
+    } else if (ffStrEqualsIgnCase(key, "--sampler")) {
+        ffSamplerRun(value ? ffOptionParseUInt32(key, value) : 1000);
+        exit(0);
     } else {
         return;
     }
@@ -765,9 +778,12 @@ static void run(FFdata* data) {
     ffStart();
 
     if (!data->resultDoc) {
-        ffLogoPrint();
+        FF_TRACE_SPAN(span, "logo", "ffLogoPrint");
+        ffLogoPrint(); // Outside of the frame; image logos are written to fd 1 and then query the cursor position
     }
 
+    ffFrameBegin();
+
 #if defined(_WIN32)
     if (!instance.config.display.noBuffer) {
         fflush(stdout);
@@ -784,9 +800,9 @@ static void run(FFdata* data) {
         if (instance.state.dynamicInterval > 0) {
             ffLogoPrintRemaining(); // `logoLineCacheClear` inside so that ffLogoPrintLine will use `\e[nC` to move the cursor to the right position instead of reprinting the logo
             fputs("\e[J", stdout); // Clear from cursor to the end of the screen to prevent artifacts when the new output is shorter than the previous one
+            ffFrameEnd(); // Moves the cursor to the top left corner first, and redraws the changed lines only
             fflush(stdout);
             ffTimeSleep(instance.state.dynamicInterval);
-            fputs("\e[H", stdout); // Move cursor to the top left corner to overwrite the previous output
             instance.state.keysHeight = 0; // Reset keysHeight so `ffLogoPrintRemaining` will recalculate it
         } else {
             break;
@@ -797,14 +813,18 @@ static void run(FFdata* data) {
         } else {
             ffPrepareCommandOption(data);
         }
+        ffFrameBegin();
     }
 
     if (data->resultDoc) {
+        ffFrameEnd();
         yyjson_mut_write_fp(stdout, data->resultDoc, YYJSON_WRITE_INF_AND_NAN_AS_NULL | YYJSON_WRITE_PRETTY_TWO_SPACES | YYJSON_WRITE_NEWLINE_AT_END, NULL, NULL);
     } else {
         if (instance.config.logo.printRemaining) {
+            FF_TRACE_SPAN(span, "logo", "ffLogoPrintRemaining");
             ffLogoPrintRemaining();
         }
+        ffFrameEnd();
         ffFinish();
     }
 }
@@ -847,6 +867,14 @@ static void writeConfigFile(FFdata* data) {
 }
 
 int main(int argc, char** argv) {
+    // Enable tracing before `ffInitInstance` so that platform initialization is traced too
+    for (int i = 1; i < argc - 1; ++i) {
+        if (ffStrEqualsIgnCase(argv[i], "--stat-trace")) {
+            ffTraceStart(argv[i + 1]);
+            break;
+        }
+    }
+
     ffInitInstance();
     atexit(ffDestroyInstance);
 
@@ -22,7 +22,8 @@ typedef struct FFconfig {
 } FFconfig;
 
 typedef struct FFLogoLineCacheState {
-    FFlist lines;
+    FFstrbuf chars; // All lines, rendered
+    FFlist lines; // List of FFLogoCachedLine
     uint32_t nextLine;
     uint32_t rightOffset;
 } FFLogoLineCacheState;
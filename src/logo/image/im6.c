@@ -20,7 +20,6 @@ FFLogoImageResult ffLogoPrintImageIM6(FFLogoRequestData* requestData) {
                                                                      .library = imageMagick,
                                                                  });
 
-    imageMagick = NULL; // leak imageMagick to prevent fastfetch from crashing #552
     return result;
 }
 
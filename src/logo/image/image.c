@@ -344,19 +344,19 @@ static bool printImageKittyDirect(bool printError) {
 
     #define FF_KITTY_MAX_CHUNK_SIZE 4096
 
-    #define FF_CACHE_FILE_HEIGHT "height"
-    #define FF_CACHE_FILE_WIDTH "width"
-    #define FF_CACHE_FILE_SIXEL "sixel"
-    #define FF_CACHE_FILE_KITTY_COMPRESSED "kittyc"
-    #define FF_CACHE_FILE_KITTY_UNCOMPRESSED "kittyu"
-    #define FF_CACHE_FILE_CHAFA "chafa"
+    #define FF_IMAGE_CACHE_MAGIC "FFIMG\0\0\1" // The last byte is the format version
+    #define FF_IMAGE_CACHE_EXTENSION ".ffimg"
+    #define FF_IMAGE_CACHE_MAX_SIZE (64u << 20) // Least recently used entries are evicted above this total size
 
     #include <string.h>
     #include <unistd.h>
     #include <fcntl.h>
+    #include <inttypes.h>
+    #include <sys/stat.h>
 
     #ifndef _WIN32
         #include <sys/ioctl.h>
+        #include <ftw.h>
     #else
         #include <wincon.h>
         #include "common/path.h"
@@ -422,36 +422,182 @@ static inline bool checkAllocationResult(void* data, size_t length) {
     return true;
 }
 
-static void writeCacheStrbuf(FFLogoRequestData* requestData, const FFstrbuf* value, const char* cacheFileName) {
-    uint32_t cacheDirLength = requestData->cacheDir.length;
-    ffStrbufAppendS(&requestData->cacheDir, cacheFileName);
-    ffWriteFileBuffer(requestData->cacheDir.chars, value);
-    ffStrbufSubstrBefore(&requestData->cacheDir, cacheDirLength);
+// A cache entry is a single file `$cacheDir/fastfetch/images/<key>.ffimg`: this header, followed by the rendered output
+typedef struct FFImageCacheHeader {
+    char magic[8];
+    uint32_t type; // FFLogoType the payload is rendered for
+    uint32_t characterWidth;
+    uint32_t characterHeight;
+    uint32_t payloadLength;
+} FFImageCacheHeader;
+
+typedef struct FFImageCacheEntry {
+    char name[32];
+    uint64_t size;
+    int64_t lastUsed;
+} FFImageCacheEntry;
+
+static int sortByLastUsed(const FFImageCacheEntry* a, const FFImageCacheEntry* b) {
+    return a->lastUsed < b->lastUsed ? -1 : a->lastUsed > b->lastUsed;
 }
 
-static void writeCacheUint32(FFLogoRequestData* requestData, uint32_t value, const char* cacheFileName) {
-    FFstrbuf content;
-    content.chars = (char*) &value;
-    content.length = sizeof(value);
-    writeCacheStrbuf(requestData, &content, cacheFileName);
+    #ifndef _WIN32
+static int removeLegacyCacheEntry(const char* path, FF_A_UNUSED const struct stat* st, FF_A_UNUSED int type, FF_A_UNUSED struct FTW* ftw) {
+    remove(path);
+    return 0;
 }
+    #endif
 
-static void printImagePixels(FFLogoRequestData* requestData, const FFstrbuf* result, const char* cacheFileName) {
-    const FFOptionsLogo* options = &instance.config.logo;
-    // Calculate character dimensions
-    instance.state.logoWidth = requestData->logoCharacterWidth + options->paddingLeft + options->paddingRight;
-    instance.state.logoHeight = requestData->logoCharacterHeight + options->paddingTop - 1;
+// Older versions cached images as `images/<realpath>/<W>*<H>/<format>`. Removes such a directory tree
+static void removeLegacyCache(FFstrbuf* path) {
+    #ifndef _WIN32
+    nftw(path->chars, removeLegacyCacheEntry, 16, FTW_DEPTH | FTW_PHYS);
+    #else
+    uint32_t length = path->length;
+    ffStrbufAppendS(path, "/*");
+    WIN32_FIND_DATAA entry;
+    HANDLE hFind = FindFirstFileA(path->chars, &entry);
+    if (hFind != INVALID_HANDLE_VALUE) {
+        do {
+            if (ffStrEquals(entry.cFileName, ".") || ffStrEquals(entry.cFileName, "..")) {
+                continue;
+            }
+
+            ffStrbufSubstrBefore(path, length + 1);
+            ffStrbufAppendS(path, entry.cFileName);
+            if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                DeleteFileA(path->chars);
+            } else if (entry.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+                RemoveDirectoryA(path->chars); // Don't follow junctions
+            } else {
+                removeLegacyCache(path);
+            }
+        } while (FindNextFileA(hFind, &entry));
+        FindClose(hFind);
+    }
+    ffStrbufSubstrBefore(path, length);
+    RemoveDirectoryA(path->chars);
+    #endif
+}
+
+// Entries are touched whenever they are printed, so the modification time is the time of last use
+static void evictCache(const FFstrbuf* cachePath) {
+    uint32_t dirLength = ffStrbufLastIndexC(cachePath, '/') + 1;
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateNS(dirLength, cachePath->chars);
+    FF_LIST_AUTO_DESTROY entries = ffListCreate();
+    uint64_t totalSize = 0;
+
+    #ifndef _WIN32
+    FF_AUTO_CLOSE_DIR DIR* dir = opendir(path.chars);
+    if (!dir) {
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        struct stat st;
+        if (ffStrEquals(entry->d_name, ".") || ffStrEquals(entry->d_name, "..") ||
+            fstatat(dirfd(dir), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) < 0) {
+            continue;
+        }
+
+        if (S_ISDIR(st.st_mode)) {
+            ffStrbufSubstrBefore(&path, dirLength);
+            ffStrbufAppendS(&path, entry->d_name);
+            removeLegacyCache(&path);
+            continue;
+        }
+
+        if (!ffStrEndsWith(entry->d_name, FF_IMAGE_CACHE_EXTENSION) || strlen(entry->d_name) >= sizeof(((FFImageCacheEntry*) NULL)->name) ||
+            !S_ISREG(st.st_mode)) {
+            continue;
+        }
+
+        FFImageCacheEntry* item = FF_LIST_ADD(FFImageCacheEntry, entries);
+        strcpy(item->name, entry->d_name);
+        item->size = (uint64_t) st.st_size;
+        item->lastUsed = (int64_t) st.st_mtime;
+        totalSize += item->size;
+    }
+    #else
+    ffStrbufAppendS(&path, "*");
+    WIN32_FIND_DATAA entry;
+    HANDLE hFind = FindFirstFileA(path.chars, &entry);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    do {
+        if (ffStrEquals(entry.cFileName, ".") || ffStrEquals(entry.cFileName, "..")) {
+            continue;
+        }
+
+        if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            ffStrbufSubstrBefore(&path, dirLength);
+            ffStrbufAppendS(&path, entry.cFileName);
+            removeLegacyCache(&path);
+            continue;
+        }
+
+        if (!ffStrEndsWith(entry.cFileName, FF_IMAGE_CACHE_EXTENSION) || strlen(entry.cFileName) >= sizeof(((FFImageCacheEntry*) NULL)->name)) {
+            continue;
+        }
 
-    // Write cache files
-    writeCacheStrbuf(requestData, result, cacheFileName);
+        FFImageCacheEntry* item = FF_LIST_ADD(FFImageCacheEntry, entries);
+        strcpy(item->name, entry.cFileName);
+        item->size = ((uint64_t) entry.nFileSizeHigh << 32) | entry.nFileSizeLow;
+        item->lastUsed = (int64_t) (((uint64_t) entry.ftLastWriteTime.dwHighDateTime << 32) | entry.ftLastWriteTime.dwLowDateTime);
+        totalSize += item->size;
+    } while (FindNextFileA(hFind, &entry));
+    FindClose(hFind);
+    #endif
+
+    if (totalSize <= FF_IMAGE_CACHE_MAX_SIZE) {
+        return;
+    }
 
-    if (options->width == 0) {
-        writeCacheUint32(requestData, requestData->logoCharacterWidth, FF_CACHE_FILE_WIDTH);
+    ffListSort(&entries, sizeof(FFImageCacheEntry), (const void*) sortByLastUsed);
+    FF_LIST_FOR_EACH (FFImageCacheEntry, item, entries) {
+        if (totalSize <= FF_IMAGE_CACHE_MAX_SIZE) {
+            break;
+        }
+        if (ffStrEndsWith(cachePath->chars, item->name)) {
+            continue; // The entry just written
+        }
+
+        ffStrbufSubstrBefore(&path, dirLength);
+        ffStrbufAppendS(&path, item->name);
+        if (remove(path.chars) == 0) {
+            totalSize -= item->size;
+        }
     }
+}
+
+static void writeCache(FFLogoRequestData* requestData, const FFstrbuf* payload) {
+    FFImageCacheHeader header = {
+        .type = requestData->type,
+        .characterWidth = requestData->logoCharacterWidth,
+        .characterHeight = requestData->logoCharacterHeight,
+        .payloadLength = payload->length,
+    };
+    memcpy(header.magic, FF_IMAGE_CACHE_MAGIC, sizeof(header.magic));
 
-    if (options->height == 0) {
-        writeCacheUint32(requestData, requestData->logoCharacterHeight, FF_CACHE_FILE_HEIGHT);
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreateA((uint32_t) sizeof(header) + payload->length + 1);
+    ffStrbufAppendNS(&content, sizeof(header), (const char*) &header);
+    ffStrbufAppend(&content, payload);
+
+    if (ffWriteFileBufferAtomic(requestData->cachePath.chars, &content)) { // Another instance may be reading the entry
+        evictCache(&requestData->cachePath);
     }
+}
+
+static void printImagePixels(FFLogoRequestData* requestData, const FFstrbuf* result) {
+    const FFOptionsLogo* options = &instance.config.logo;
+    // Calculate character dimensions
+    instance.state.logoWidth = requestData->logoCharacterWidth + options->paddingLeft + options->paddingRight;
+    instance.state.logoHeight = requestData->logoCharacterHeight + options->paddingTop - 1;
+
+    writeCache(requestData, result);
 
     // Write result to stdout
     ffPrintCharTimes('\n', options->paddingTop);
@@ -486,7 +632,7 @@ static bool printImageSixel(FFLogoRequestData* requestData, const ImageData* ima
     result.chars = (char*) blob;
     result.length = (uint32_t) length;
 
-    printImagePixels(requestData, &result, FF_CACHE_FILE_SIXEL);
+    printImagePixels(requestData, &result);
 
     free(blob);
     return true;
@@ -544,7 +690,7 @@ static bool printImageKitty(FFLogoRequestData* requestData, const ImageData* ima
         appendKittyChunk(&result, &currentPos, &remainingLength, true);
     }
 
-    printImagePixels(requestData, &result, isCompressed ? FF_CACHE_FILE_KITTY_COMPRESSED : FF_CACHE_FILE_KITTY_UNCOMPRESSED);
+    printImagePixels(requestData, &result);
 
     free(chars);
     return true;
@@ -625,7 +771,7 @@ static bool printImageChafa(FFLogoRequestData* requestData, const ImageData* ima
     result.chars = str->str;
 
     ffLogoPrintChars(result.chars, false);
-    writeCacheStrbuf(requestData, &result, FF_CACHE_FILE_CHAFA);
+    writeCache(requestData, &result);
 
     // FIXME: These functions must be imported from `libglib` dlls on Windows
     FF_LIBRARY_LOAD_SYMBOL_LAZY(chafa, g_string_free);
@@ -744,88 +890,56 @@ FFLogoImageResult ffLogoPrintImageImpl(FFLogoRequestData* requestData, const FFI
     return printSuccessful ? FF_LOGO_IMAGE_RESULT_SUCCESS : FF_LOGO_IMAGE_RESULT_RUN_ERROR;
 }
 
-static FFNativeFD getCacheFD(FFLogoRequestData* requestData, const char* fileName) {
-    uint32_t cacheDirLength = requestData->cacheDir.length;
-    ffStrbufAppendS(&requestData->cacheDir, fileName);
+static bool isCacheComplete(FFNativeFD fd, const FFImageCacheHeader* header) {
     #ifndef _WIN32
-    int fd = open(requestData->cacheDir.chars, O_RDONLY
+    struct stat st;
+    return fstat(fd, &st) == 0 && (uint64_t) st.st_size == sizeof(*header) + header->payloadLength;
+    #else
+    LARGE_INTEGER size;
+    return GetFileSizeEx(fd, &size) && (uint64_t) size.QuadPart == sizeof(*header) + header->payloadLength;
+    #endif
+}
+
+static bool printCachedImage(FFLogoRequestData* requestData) {
+    FFOptionsLogo* options = &instance.config.logo;
+
+    #ifndef _WIN32
+    FF_AUTO_CLOSE_FD FFNativeFD fd = open(requestData->cachePath.chars, O_RDONLY
         #ifdef O_CLOEXEC
             | O_CLOEXEC
         #endif
     );
     #else
-    HANDLE fd = CreateFileA(requestData->cacheDir.chars, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    FF_AUTO_CLOSE_FD FFNativeFD fd = CreateFileA(requestData->cachePath.chars, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
     #endif
-    ffStrbufSubstrBefore(&requestData->cacheDir, cacheDirLength);
-    return fd;
-}
-
-static void readCachedStrbuf(FFLogoRequestData* requestData, FFstrbuf* result, const char* cacheFileName) {
-    uint32_t cacheDirLength = requestData->cacheDir.length;
-    ffStrbufAppendS(&requestData->cacheDir, cacheFileName);
-    ffAppendFileBuffer(requestData->cacheDir.chars, result);
-    ffStrbufSubstrBefore(&requestData->cacheDir, cacheDirLength);
-}
-
-static uint32_t readCachedUint32(FFLogoRequestData* requestData, const char* cacheFileName) {
-    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
-    readCachedStrbuf(requestData, &content, cacheFileName);
-
-    uint32_t result = 0;
-
-    if (content.length != sizeof(result)) {
-        return 0;
+    if (!ffIsValidNativeFD(fd)) {
+        return false;
     }
 
-    memcpy(&result, content.chars, sizeof(result));
-
-    return result;
-}
-
-static bool printCachedChars(FFLogoRequestData* requestData, const char* cacheFileName) {
-    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
-    readCachedStrbuf(requestData, &content, cacheFileName);
-
-    if (content.length == 0) {
+    FFImageCacheHeader header;
+    if (ffReadFDData(fd, sizeof(header), &header) != (ssize_t) sizeof(header) ||
+        memcmp(header.magic, FF_IMAGE_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.type != requestData->type ||
+        header.characterWidth == 0 || header.characterHeight == 0 || header.payloadLength == 0 ||
+        !isCacheComplete(fd, &header)) {
         return false;
     }
 
-    ffLogoPrintChars(content.chars, false);
-    return true;
-}
-
-static bool printCachedPixel(FFLogoRequestData* requestData) {
-    FFOptionsLogo* options = &instance.config.logo;
-
-    requestData->logoCharacterWidth = options->width;
-    if (requestData->logoCharacterWidth == 0) {
-        requestData->logoCharacterWidth = readCachedUint32(requestData, FF_CACHE_FILE_WIDTH);
-        if (requestData->logoCharacterWidth == 0) {
-            return false;
-        }
-    }
+    #ifndef _WIN32
+    futimens(fd, NULL); // Mark as recently used for `evictCache`
+    #endif
 
-    requestData->logoCharacterHeight = options->height;
-    if (requestData->logoCharacterHeight == 0) {
-        requestData->logoCharacterHeight = readCachedUint32(requestData, FF_CACHE_FILE_HEIGHT);
-        if (requestData->logoCharacterHeight == 0) {
+    if (requestData->type == FF_LOGO_TYPE_IMAGE_CHAFA) {
+        FF_STRBUF_AUTO_DESTROY content = ffStrbufCreateA(header.payloadLength + 1);
+        if (!ffAppendFDBuffer(fd, &content) || content.length != header.payloadLength) {
             return false;
         }
+        ffLogoPrintChars(content.chars, false);
+        return true;
     }
 
-    FF_AUTO_CLOSE_FD FFNativeFD fd = FF_INVALID_FD;
-    if (requestData->type == FF_LOGO_TYPE_IMAGE_KITTY) {
-        fd = getCacheFD(requestData, FF_CACHE_FILE_KITTY_COMPRESSED);
-        if (!ffIsValidNativeFD(fd)) {
-            fd = getCacheFD(requestData, FF_CACHE_FILE_KITTY_UNCOMPRESSED);
-        }
-    } else if (requestData->type == FF_LOGO_TYPE_IMAGE_SIXEL) {
-        fd = getCacheFD(requestData, FF_CACHE_FILE_SIXEL);
-    }
-
-    if (!ffIsValidNativeFD(fd)) {
-        return false;
-    }
+    requestData->logoCharacterWidth = options->width ? options->width : header.characterWidth;
+    requestData->logoCharacterHeight = options->height ? options->height : header.characterHeight;
 
     ffPrintCharTimes('\n', options->paddingTop);
     if (options->position == FF_LOGO_POSITION_RIGHT) {
@@ -835,23 +949,19 @@ static bool printCachedPixel(FFLogoRequestData* requestData) {
     }
     fflush(stdout);
 
-    bool sent = false;
+    // The payload follows the header, so both copies continue from the current file offset
+    size_t remaining = header.payloadLength;
     #ifdef __linux__
-    struct stat st;
-    if (fstat(fd, &st) >= 0) {
-        while (st.st_size > 0) {
-            ssize_t bytes = sendfile(STDOUT_FILENO, fd, NULL, (size_t) st.st_size);
-            if (bytes > 0) {
-                sent = true;
-                st.st_size -= bytes;
-            } else {
-                break;
-            }
+    while (remaining > 0) {
+        ssize_t bytes = sendfile(STDOUT_FILENO, fd, NULL, remaining);
+        if (bytes <= 0) {
+            break;
         }
+        remaining -= (size_t) bytes;
     }
     #endif
 
-    if (!sent) {
+    if (remaining > 0) {
         char buffer[32768];
         ssize_t readBytes;
         while ((readBytes = ffReadFDData(fd, sizeof(buffer), buffer)) > 0) {
@@ -873,6 +983,59 @@ static bool printCachedPixel(FFLogoRequestData* requestData) {
     return true;
 }
 
+static uint64_t hashData(uint64_t hash, size_t length, const void* data) {
+    // FNV-1a, consuming 64-bit words; the xor-shift folds high bits down, which plain FNV does per byte
+    const uint8_t* p = data;
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t), p += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ULL;
+        hash ^= hash >> 32;
+    }
+    for (; length > 0; --length, ++p) {
+        hash = (hash ^ *p) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Entries are addressed by the image file (real path, size and mtime) and by everything the rendered output depends on,
+// so a hit doesn't need to read the image. Edited images get a new entry; moved or duplicated images don't share one
+static uint64_t getCacheKey(const FFLogoRequestData* requestData, const char* imagePath, const struct stat* imageStat) {
+    uint64_t hash = hashData(14695981039346656037ULL, strlen(imagePath), imagePath);
+    uint64_t fileParams[] = {
+        (uint64_t) imageStat->st_size,
+        (uint64_t) imageStat->st_mtime,
+    };
+    hash = hashData(hash, sizeof(fileParams), fileParams);
+    uint32_t params[] = {
+        requestData->type,
+        requestData->logoPixelWidth,
+        requestData->logoPixelHeight,
+    };
+    hash = hashData(hash, sizeof(params), params);
+    hash = hashData(hash, sizeof(requestData->characterPixelWidth), &requestData->characterPixelWidth);
+    hash = hashData(hash, sizeof(requestData->characterPixelHeight), &requestData->characterPixelHeight);
+
+    #ifdef FF_HAVE_CHAFA
+    if (requestData->type == FF_LOGO_TYPE_IMAGE_CHAFA) {
+        const FFOptionsLogo* options = &instance.config.logo;
+        uint32_t chafaParams[] = {
+            options->chafaFgOnly,
+            options->chafaCanvasMode,
+            options->chafaColorSpace,
+            options->chafaDitherMode,
+        };
+        hash = hashData(hash, sizeof(chafaParams), chafaParams);
+        hash = hashData(hash, options->chafaSymbols.length, options->chafaSymbols.chars);
+    }
+    #endif
+
+    // Final avalanche of splitmix64
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
 static bool getCharacterPixelDimensions(FFLogoRequestData* requestData) {
     #ifdef _WIN32
 
@@ -912,38 +1075,21 @@ static bool printImageIfExistsSlowPath(FFLogoType type, bool printError) {
     requestData.logoPixelWidth = (uint32_t) ceil((double) instance.config.logo.width * requestData.characterPixelWidth);
     requestData.logoPixelHeight = (uint32_t) ceil((double) instance.config.logo.height * requestData.characterPixelHeight);
 
-    ffStrbufInit(&requestData.cacheDir);
-    ffStrbufAppend(&requestData.cacheDir, &instance.state.platform.cacheDir);
-    ffStrbufAppendS(&requestData.cacheDir, "fastfetch/images");
-
-    ffStrbufEnsureFree(&requestData.cacheDir, PATH_MAX);
-    char* filePath = requestData.cacheDir.chars + requestData.cacheDir.length;
-    if (realpath(instance.config.logo.source.chars, filePath) == NULL) {
-        // We can safely return here, because if realpath failed, we surely won't be able to read the file
-        ffStrbufDestroy(&requestData.cacheDir);
+    char imagePath[PATH_MAX];
+    struct stat imageStat;
+    if (realpath(instance.config.logo.source.chars, imagePath) == NULL || stat(imagePath, &imageStat) != 0) {
         if (printError) {
             fputs("Logo: Querying realpath of the image source failed\n", stderr);
         }
         return false;
     }
 
-    #ifdef _WIN32
-    filePath[1] = filePath[0]; // Drive Name
-    filePath[0] = '/';
-    #endif
+    ffStrbufInitCopy(&requestData.cachePath, &instance.state.platform.cacheDir);
+    ffStrbufAppendF(&requestData.cachePath, "fastfetch/images/%016" PRIx64 FF_IMAGE_CACHE_EXTENSION, getCacheKey(&requestData, imagePath, &imageStat));
 
-    ffStrbufRecalculateLength(&requestData.cacheDir);
-    ffStrbufEnsureEndsWithC(&requestData.cacheDir, '/');
-    ffStrbufAppendF(&requestData.cacheDir, "%u*%u/", requestData.logoPixelWidth, requestData.logoPixelHeight);
-
-    if (!instance.config.logo.recache) {
-        bool cacheValid = requestData.type == FF_LOGO_TYPE_IMAGE_CHAFA
-            ? printCachedChars(&requestData, FF_CACHE_FILE_CHAFA)
-            : printCachedPixel(&requestData);
-        if (cacheValid) {
-            ffStrbufDestroy(&requestData.cacheDir);
-            return true;
-        }
+    if (!instance.config.logo.recache && printCachedImage(&requestData)) {
+        ffStrbufDestroy(&requestData.cachePath);
+        return true;
     }
 
     FFLogoImageResult result = FF_LOGO_IMAGE_RESULT_INIT_ERROR;
@@ -958,7 +1104,7 @@ static bool printImageIfExistsSlowPath(FFLogoType type, bool printError) {
     }
     #endif
 
-    ffStrbufDestroy(&requestData.cacheDir);
+    ffStrbufDestroy(&requestData.cachePath);
 
     if (result == FF_LOGO_IMAGE_RESULT_SUCCESS) {
         return true;
@@ -12,7 +12,7 @@ typedef enum FF_A_PACKED FFLogoImageResult {
 
 typedef struct FFLogoRequestData {
     FFLogoType type;
-    FFstrbuf cacheDir;
+    FFstrbuf cachePath; // Content-addressed cache entry, see `getCacheKey`
 
     double characterPixelWidth;
     double characterPixelHeight;
@@ -2,6 +2,7 @@
 #include "common/io.h"
 #include "common/printing.h"
 #include "common/processing.h"
+#include "common/resultcache.h"
 #include "common/textModifier.h"
 #include "common/strutil.h"
 #include "detection/media/media.h"
@@ -12,33 +13,40 @@
 #include <stdlib.h>
 #include <string.h>
 
+// A line of the logo, as a span of `FFLogoLineCacheState::chars`
 typedef struct FFLogoCachedLine {
-    FFstrbuf chars;
+    uint32_t start;
+    uint32_t length;
     uint32_t width;
 } FFLogoCachedLine;
 
 static void logoLineCacheClear(FFLogoLineCacheState* cache) {
-    FF_LIST_FOR_EACH (FFLogoCachedLine, line, cache->lines) {
-        ffStrbufDestroy(&line->chars);
-    }
+    ffStrbufDestroy(&cache->chars);
     ffListDestroy(&cache->lines);
     cache->nextLine = 0;
     cache->rightOffset = 0;
 }
 
-static void logoLineCachePush(const FFstrbuf* chars, uint32_t width, FFLogoLineCacheState* cache) {
-    FFLogoCachedLine* line = FF_LIST_ADD(FFLogoCachedLine, cache->lines);
+// End the line that starts at `cache->chars.chars[start]`
+static void logoLineCacheEndLine(FFLogoLineCacheState* cache, uint32_t start, uint32_t width) {
     if (width > 0) {
-        ffStrbufInitCopy(&line->chars, chars);
         if (!instance.config.display.pipe) {
-            ffStrbufAppendS(&line->chars, FASTFETCH_TEXT_MODIFIER_RESET);
+            ffStrbufAppendS(&cache->chars, FASTFETCH_TEXT_MODIFIER_RESET);
         }
     } else {
-        ffStrbufInit(&line->chars);
+        ffStrbufSubstrBefore(&cache->chars, start);
     }
+
+    FFLogoCachedLine* line = FF_LIST_ADD(FFLogoCachedLine, cache->lines);
+    line->start = start;
+    line->length = cache->chars.length - start;
     line->width = width;
 }
 
+static inline void logoLineCacheWriteLine(const FFLogoLineCacheState* cache, const FFLogoCachedLine* line) {
+    fwrite(cache->chars.chars + line->start, 1, line->length, stdout);
+}
+
 static void logoLineCacheBuild(FFLogoLineCacheState* cache, const char* data, bool doColorReplacement) {
     FFOptionsLogo* options = &instance.config.logo;
     bool keepCarryColor = options->type != FF_LOGO_TYPE_IMAGE_CHAFA;
@@ -56,30 +64,33 @@ static void logoLineCacheBuild(FFLogoLineCacheState* cache, const char* data, bo
     }
 
     for (uint32_t i = 0; i < options->paddingTop; ++i) {
-        logoLineCachePush(NULL, 0, cache);
+        logoLineCacheEndLine(cache, cache->chars.length, 0);
     }
 
     if (*data != '\0') {
+        // All lines are rendered into one buffer
+        FFstrbuf* line = &cache->chars;
+        ffStrbufEnsureFree(line, (uint32_t) strlen(data));
         while (true) {
-            FF_STRBUF_AUTO_DESTROY line = ffStrbufCreateA(256);
+            uint32_t lineStart = line->length;
             uint32_t lineWidth = 0;
 
             if (!instance.config.display.pipe && instance.config.display.brightColor) {
-                ffStrbufAppendS(&line, FASTFETCH_TEXT_MODIFIER_BOLT);
+                ffStrbufAppendS(line, FASTFETCH_TEXT_MODIFIER_BOLT);
             }
 
             if (keepCarryColor && carryColor.length > 0) {
-                ffStrbufAppend(&line, &carryColor);
+                ffStrbufAppend(line, &carryColor);
             }
 
             if ((options->position != FF_LOGO_POSITION_RIGHT) && options->paddingLeft > 0) {
-                ffStrbufAppendNC(&line, options->paddingLeft, ' ');
+                ffStrbufAppendNC(line, options->paddingLeft, ' ');
                 lineWidth += options->paddingLeft;
             }
 
             while (*data != '\0' && *data != '\n' && !(*data == '\r' && *(data + 1) == '\n')) {
                 if (*data == '\t') {
-                    ffStrbufAppendNC(&line, 4, ' ');
+                    ffStrbufAppendNC(line, 4, ' ');
                     lineWidth += 4;
                     ++data;
                     continue;
@@ -97,7 +108,7 @@ static void logoLineCacheBuild(FFLogoLineCacheState* cache, const char* data, bo
                         ++data;
 
                         uint32_t escLen = (uint32_t) (data - start);
-                        ffStrbufAppendNS(&line, escLen, start);
+                        ffStrbufAppendNS(line, escLen, start);
 
                         if (keepCarryColor && start[escLen - 1] == 'm') {
                             ffStrbufSetNS(&carryColor, escLen, start);
@@ -112,7 +123,7 @@ static void logoLineCacheBuild(FFLogoLineCacheState* cache, const char* data, bo
                     ++data;
 
                     if (*data == '$' || *data == '\0') {
-                        ffStrbufAppendC(&line, '$');
+                        ffStrbufAppendC(line, '$');
                         ++lineWidth;
                         ++data;
                         continue;
@@ -123,15 +134,15 @@ static void logoLineCacheBuild(FFLogoLineCacheState* cache, const char* data, bo
                         if (index >= 0 && index < FASTFETCH_LOGO_MAX_COLORS) {
                             if (keepCarryColor) {
                                 ffStrbufSetF(&carryColor, "\e[%sm", options->colors[index].chars);
-                                ffStrbufAppend(&line, &carryColor);
+                                ffStrbufAppend(line, &carryColor);
                             } else {
-                                ffStrbufAppendF(&line, "\e[%sm", options->colors[index].chars);
+                                ffStrbufAppendF(line, "\e[%sm", options->colors[index].chars);
                             }
                             ++data;
                             continue;
                         }
 
-                        ffStrbufAppendC(&line, '$');
+                        ffStrbufAppendC(line, '$');
                         ++lineWidth;
                     } else {
                         ++data;
@@ -148,12 +159,12 @@ static void logoLineCacheBuild(FFLogoLineCacheState* cache, const char* data, bo
                         break;
                     }
 
-                    ffStrbufAppendC(&line, *data);
+                    ffStrbufAppendC(line, *data);
                     ++data;
                 }
             }
 
-            logoLineCachePush(&line, lineWidth, cache);
+            logoLineCacheEndLine(cache, lineStart, lineWidth);
             if (lineWidth > maxLineWidth) {
                 maxLineWidth = lineWidth;
             }
@@ -184,7 +195,7 @@ static void logoLineCacheBuild(FFLogoLineCacheState* cache, const char* data, bo
 
     uint32_t totalLines = instance.state.logoHeight + 1;
     while (cache->lines.length < totalLines) {
-        logoLineCachePush(NULL, 0, cache);
+        logoLineCacheEndLine(cache, cache->chars.length, 0);
     }
 
     cache->nextLine = 0;
@@ -264,19 +275,86 @@ static bool ffLogoPrintCharsRaw(const char* data, size_t length, bool printError
     return true;
 }
 
-void ffLogoPrintChars(const char* data, bool doColorReplacement) {
-    FFOptionsLogo* options = &instance.config.logo;
-    FFLogoLineCacheState* cache = &instance.state.logoLineCache;
+// Everything `logoLineCacheBuild` depends on, besides the logo itself
+static void logoLineCacheGetOptions(FFstrbuf* result, bool doColorReplacement) {
+    const FFOptionsLogo* options = &instance.config.logo;
+    ffStrbufSetF(result, "%d;%d;%d;%u;%u;%u;%u;%u;%u;%u",
+        doColorReplacement, instance.config.display.pipe, instance.config.display.brightColor,
+        (unsigned) options->type, (unsigned) options->position,
+        options->width, options->height, options->paddingTop, options->paddingLeft, options->paddingRight);
+    for (uint32_t i = 0; i < FASTFETCH_LOGO_MAX_COLORS; ++i) {
+        ffStrbufAppendC(result, ';');
+        ffStrbufAppend(result, &options->colors[i]);
+    }
+}
 
-    logoLineCacheBuild(cache, data, doColorReplacement);
+// Restore the lines rendered by a previous run, if neither the logo `name` nor the render options changed
+static bool logoLineCacheRestore(FFLogoLineCacheState* cache, const char* name, const FFResultCacheKey* keys, const FFstrbuf* renderOptions) {
+    FFResultCacheReader reader;
+    if (!ffResultCacheGet(name, keys, &reader)) {
+        return false;
+    }
+
+    FF_STRBUF_AUTO_DESTROY cachedOptions = ffStrbufCreate();
+    if (!ffResultCacheReadStrbuf(&reader, &cachedOptions) || !ffStrbufEqual(&cachedOptions, renderOptions)) {
+        return false;
+    }
+
+    logoLineCacheClear(cache);
+    uint32_t count, logoWidth, logoHeight, rightOffset;
+    if (!ffResultCacheReadStrbuf(&reader, &cache->chars) ||
+        !ffResultCacheReadData(&reader, sizeof(count), &count) || count == 0 ||
+        reader.remaining / sizeof(FFLogoCachedLine) < count) {
+        logoLineCacheClear(cache);
+        return false;
+    }
+
+    ffListReserve(&cache->lines, sizeof(FFLogoCachedLine), count);
+    ffResultCacheReadData(&reader, count * (uint32_t) sizeof(FFLogoCachedLine), cache->lines.data);
+    cache->lines.length = count;
+
+    if (!ffResultCacheReadData(&reader, sizeof(logoWidth), &logoWidth) ||
+        !ffResultCacheReadData(&reader, sizeof(logoHeight), &logoHeight) ||
+        !ffResultCacheReadData(&reader, sizeof(rightOffset), &rightOffset)) {
+        logoLineCacheClear(cache);
+        return false;
+    }
+
+    FF_LIST_FOR_EACH (FFLogoCachedLine, line, cache->lines) {
+        if (line->start > cache->chars.length || line->length > cache->chars.length - line->start) {
+            logoLineCacheClear(cache);
+            return false;
+        }
+    }
 
+    instance.state.logoWidth = logoWidth;
+    instance.state.logoHeight = logoHeight;
+    cache->rightOffset = rightOffset;
+    return true;
+}
+
+static void logoLineCacheStore(const FFLogoLineCacheState* cache, const char* name, const FFResultCacheKey* keys, const FFstrbuf* renderOptions) {
+    FF_STRBUF_AUTO_DESTROY data = ffStrbufCreate();
+    ffResultCacheWriteStrbuf(&data, renderOptions);
+    ffResultCacheWriteStrbuf(&data, &cache->chars);
+    ffResultCacheWriteData(&data, sizeof(cache->lines.length), &cache->lines.length);
+    ffResultCacheWriteData(&data, cache->lines.length * (uint32_t) sizeof(FFLogoCachedLine), cache->lines.data);
+    ffResultCacheWriteData(&data, sizeof(instance.state.logoWidth), &instance.state.logoWidth);
+    ffResultCacheWriteData(&data, sizeof(instance.state.logoHeight), &instance.state.logoHeight);
+    ffResultCacheWriteData(&data, sizeof(cache->rightOffset), &cache->rightOffset);
+    ffResultCacheSet(name, keys, &data);
+}
+
+// Print the logo at the top, if configured. Otherwise its lines are printed along with the modules
+static void logoLineCachePrintTop(FFLogoLineCacheState* cache) {
+    FFOptionsLogo* options = &instance.config.logo;
     if (options->position != FF_LOGO_POSITION_TOP) {
         return;
     }
 
-    FF_STRBUF_AUTO_DESTROY result = ffStrbufCreateA(4096);
+    FF_STRBUF_AUTO_DESTROY result = ffStrbufCreateA(cache->chars.length + cache->lines.length + options->paddingBottom + 1);
     FF_LIST_FOR_EACH (FFLogoCachedLine, line, cache->lines) {
-        ffStrbufAppend(&result, &line->chars);
+        ffStrbufAppendNS(&result, line->length, cache->chars.chars + line->start);
         ffStrbufAppendC(&result, '\n');
     }
     ffStrbufAppendNC(&result, options->paddingBottom, '\n');
@@ -285,6 +363,12 @@ void ffLogoPrintChars(const char* data, bool doColorReplacement) {
     logoLineCacheClear(cache);
 }
 
+void ffLogoPrintChars(const char* data, bool doColorReplacement) {
+    FFLogoLineCacheState* cache = &instance.state.logoLineCache;
+    logoLineCacheBuild(cache, data, doColorReplacement);
+    logoLineCachePrintTop(cache);
+}
+
 static void logoApplyColors(const FFlogo* logo, bool replacement) {
     if (instance.config.display.colorTitle.length == 0) {
         ffStrbufAppendS(&instance.config.display.colorTitle, logo->colorTitle ?: logo->colors[0]);
@@ -311,13 +395,12 @@ static bool logoHasName(const FFlogo* logo, const FFstrbuf* name, bool small) {
         const char* const* logoName = logo->names;
         *logoName != NULL && logoName <= &logo->names[FASTFETCH_LOGO_MAX_NAMES];
         ++logoName) {
-        if (small) {
-            uint32_t logoNameLength = (uint32_t) (strlen(*logoName) - strlen("_small"));
-            if (name->length == logoNameLength && strncasecmp(*logoName, name->chars, logoNameLength) == 0) {
-                return true;
-            }
+        // Compare lengths first; most names in the same bucket differ in length
+        uint32_t logoNameLength = (uint32_t) strlen(*logoName);
+        if (small && name->length + strlen("_small") == logoNameLength && strncasecmp(*logoName, name->chars, name->length) == 0) {
+            return true;
         }
-        if (ffStrbufIgnCaseEqualS(name, *logoName)) {
+        if (name->length == logoNameLength && strcasecmp(*logoName, name->chars) == 0) {
             return true;
         }
     }
@@ -355,7 +438,7 @@ static const FFlogo* logoGetBuiltin(const FFstrbuf* name, FFLogoSize size) {
     return NULL;
 }
 
-static const FFlogo* logoGetBuiltinDetected(FFLogoSize size) {
+static const FFlogo* logoGetBuiltinDetectedImpl(FFLogoSize size) {
     const FFOSResult* os = ffDetectOS();
 
     const FFlogo* logo = logoGetBuiltin(&os->id, size);
@@ -399,10 +482,35 @@ static const FFlogo* logoGetBuiltinDetected(FFLogoSize size) {
     return &ffLogoUnknown;
 }
 
+// The detected OS never changes, but its logo is looked up for colors and as fallback several times per run
+static const FFlogo* logoGetBuiltinDetected(FFLogoSize size) {
+    static const FFlogo* detected[FF_LOGO_SIZE_SMALL + 1];
+    if (detected[size] == NULL) {
+        detected[size] = logoGetBuiltinDetectedImpl(size);
+    }
+    return detected[size];
+}
+
 static void logoPrintStruct(const FFlogo* logo) {
     logoApplyColors(logo, true);
 
-    ffLogoPrintChars(logo->lines, true);
+    if (!instance.config.general.resultCache) {
+        ffLogoPrintChars(logo->lines, true);
+        return;
+    }
+
+    // Builtin logos only change with fastfetch itself, which invalidates the whole cache
+    FFLogoLineCacheState* cache = &instance.state.logoLineCache;
+    FF_STRBUF_AUTO_DESTROY name = ffStrbufCreateF("Logo builtin:%s", logo->names[0]);
+    const FFResultCacheKey keys[] = { {} };
+    FF_STRBUF_AUTO_DESTROY renderOptions = ffStrbufCreate();
+    logoLineCacheGetOptions(&renderOptions, true);
+
+    if (!logoLineCacheRestore(cache, name.chars, keys, &renderOptions)) {
+        logoLineCacheBuild(cache, logo->lines, true);
+        logoLineCacheStore(cache, name.chars, keys, &renderOptions);
+    }
+    logoLineCachePrintTop(cache);
 }
 
 static void logoPrintNone(void) {
@@ -498,6 +606,25 @@ static bool updateLogoPath(void) {
 static bool logoPrintFileIfExists(bool doColorReplacement, bool raw) {
     FFOptionsLogo* options = &instance.config.logo;
 
+    FF_STRBUF_AUTO_DESTROY cacheName = ffStrbufCreate();
+    FF_STRBUF_AUTO_DESTROY renderOptions = ffStrbufCreate();
+    const FFResultCacheKey keys[] = {
+        { .type = FF_RESULT_CACHE_KEY_FILE_MTIME, .path = options->source.chars },
+        {},
+    };
+    if (!raw && instance.config.general.resultCache && !ffStrbufEqualS(&options->source, "-")) {
+        // Render options include the colors
+        logoApplyColors(logoGetBuiltinDetected(FF_LOGO_SIZE_NORMAL), doColorReplacement);
+        ffStrbufSetF(&cacheName, "Logo file:%s", options->source.chars);
+        logoLineCacheGetOptions(&renderOptions, doColorReplacement);
+
+        FFLogoLineCacheState* cache = &instance.state.logoLineCache;
+        if (logoLineCacheRestore(cache, cacheName.chars, keys, &renderOptions)) {
+            logoLineCachePrintTop(cache);
+            return true;
+        }
+    }
+
     FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
 
     if (ffStrbufEqualS(&options->source, "-")
@@ -514,7 +641,15 @@ static bool logoPrintFileIfExists(bool doColorReplacement, bool raw) {
         return ffLogoPrintCharsRaw(content.chars, content.length, instance.config.display.showErrors);
     }
 
-    ffLogoPrintChars(content.chars, doColorReplacement);
+    if (cacheName.length == 0) {
+        ffLogoPrintChars(content.chars, doColorReplacement);
+        return true;
+    }
+
+    FFLogoLineCacheState* cache = &instance.state.logoLineCache;
+    logoLineCacheBuild(cache, content.chars, doColorReplacement);
+    logoLineCacheStore(cache, cacheName.chars, keys, &renderOptions);
+    logoLineCachePrintTop(cache);
     return true;
 }
 
@@ -696,11 +831,11 @@ void ffLogoPrintLine(void) {
 
             if (logo->position == FF_LOGO_POSITION_RIGHT) {
                 printf("\033[9999999C\033[%uD", cache->rightOffset);
-                ffStrbufWriteTo(&line->chars, stdout);
+                logoLineCacheWriteLine(cache, line);
 
                 fputs("\033[G", stdout);
             } else {
-                ffStrbufWriteTo(&line->chars, stdout);
+                logoLineCacheWriteLine(cache, line);
 
                 uint32_t remaining = instance.state.logoWidth;
                 remaining = line->width < remaining ? remaining - line->width : 0;
@@ -734,7 +869,8 @@ void ffLogoPrintRemaining(void) {
             if (logo->position == FF_LOGO_POSITION_RIGHT) {
                 printf("\033[9999999C\033[%uD", cache->rightOffset);
             }
-            ffStrbufPutTo(&line->chars, stdout);
+            logoLineCacheWriteLine(cache, line);
+            putchar('\n');
 
             ++cache->nextLine;
         }
@@ -768,7 +904,8 @@ void ffLogoBuiltinPrint(void) {
                 ffStrbufSetF(&buf, "\e[%sm%s:\e[0m\n", logo->colors[0], logo->names[0]);
             }
             ffWriteFDBuffer(FFUnixFD2NativeFD(STDOUT_FILENO), &buf);
-            logoPrintStruct(logo);
+            logoApplyColors(logo, true);
+            ffLogoPrintChars(logo->lines, true); // Don't fill the result cache with every builtin logo
 
             for (uint8_t i = 0; i < FASTFETCH_LOGO_MAX_COLORS; i++) {
                 ffStrbufClear(&options->colors[i]);
@@ -1,75 +1,97 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
+#include "common/resultcache.h"
 #include "common/strutil.h"
 #include "detection/bios/bios.h"
 #include "modules/bios/bios.h"
 
-bool ffPrintBios(FFBiosOptions* options) {
-    bool success = false;
-    FFBiosResult bios;
-    ffStrbufInit(&bios.date);
-    ffStrbufInit(&bios.release);
-    ffStrbufInit(&bios.vendor);
-    ffStrbufInit(&bios.version);
-    ffStrbufInit(&bios.type);
+static const char* detectBiosResult(FF_A_UNUSED FFBiosOptions* options, FFBiosResult* bios) {
+    ffStrbufInit(&bios->date);
+    ffStrbufInit(&bios->release);
+    ffStrbufInit(&bios->vendor);
+    ffStrbufInit(&bios->version);
+    ffStrbufInit(&bios->type);
 
-    const char* error = ffDetectBios(&bios);
+    return ffDetectBios(bios);
+}
 
-    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+static void destroyBiosResult(FFBiosResult* bios) {
+    ffStrbufDestroy(&bios->date);
+    ffStrbufDestroy(&bios->release);
+    ffStrbufDestroy(&bios->vendor);
+    ffStrbufDestroy(&bios->version);
+    ffStrbufDestroy(&bios->type);
+}
 
+static void serializeBiosResult(FFBiosResult* bios, FFstrbuf* data) {
+    ffResultCacheWriteStrbuf(data, &bios->date);
+    ffResultCacheWriteStrbuf(data, &bios->release);
+    ffResultCacheWriteStrbuf(data, &bios->vendor);
+    ffResultCacheWriteStrbuf(data, &bios->version);
+    ffResultCacheWriteStrbuf(data, &bios->type);
+}
+
+static bool deserializeBiosResult(FFBiosResult* bios, FFResultCacheReader* reader) {
+    return ffResultCacheReadStrbuf(reader, &bios->date) &&
+        ffResultCacheReadStrbuf(reader, &bios->release) &&
+        ffResultCacheReadStrbuf(reader, &bios->vendor) &&
+        ffResultCacheReadStrbuf(reader, &bios->version) &&
+        ffResultCacheReadStrbuf(reader, &bios->type);
+}
+
+static bool printBiosResult(FFBiosOptions* options, const char* error, FFBiosResult* bios) {
     if (error) {
         ffPrintError(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
-        goto exit;
+        return false;
     }
 
-    if (bios.version.length == 0) {
+    if (bios->version.length == 0) {
         ffPrintError(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "bios_version is not set.");
-        goto exit;
+        return false;
     }
 
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+    FF_STRBUF_AUTO_DESTROY type = ffStrbufCreateCopy(&bios->type);
+
     if (options->moduleArgs.key.length == 0) {
-        if (bios.type.length == 0) {
-            ffStrbufSetStatic(&bios.type, "Unknown");
-        } else if (ffStrbufIgnCaseEqualS(&bios.type, "BIOS")) {
-            ffStrbufSetStatic(&bios.type, "Legacy");
+        if (type.length == 0) {
+            ffStrbufSetStatic(&type, "Unknown");
+        } else if (ffStrbufIgnCaseEqualS(&type, "BIOS")) {
+            ffStrbufSetStatic(&type, "Legacy");
         }
 
-        ffStrbufSetF(&key, FF_BIOS_MODULE_NAME " (%s)", bios.type.chars);
+        ffStrbufSetF(&key, FF_BIOS_MODULE_NAME " (%s)", type.chars);
     } else {
-        ffStrbufClear(&key);
         FF_PARSE_FORMAT_STRING_CHECKED(&key, &options->moduleArgs.key, ((FFformatarg[]) {
-                                                                           FF_ARG(bios.type, "type"),
+                                                                           FF_ARG(type, "type"),
                                                                            FF_ARG(options->moduleArgs.keyIcon, "icon"),
                                                                        }));
     }
 
     if (options->moduleArgs.outputFormat.length == 0) {
         ffPrintLogoAndKey(key.chars, 0, &options->moduleArgs, FF_PRINT_TYPE_NO_CUSTOM_KEY);
-        ffStrbufWriteTo(&bios.version, stdout);
-        if (bios.release.length) {
-            printf(" (%s)\n", bios.release.chars);
+        ffStrbufWriteTo(&bios->version, stdout);
+        if (bios->release.length) {
+            printf(" (%s)\n", bios->release.chars);
         } else {
             putchar('\n');
         }
     } else {
         FF_PRINT_FORMAT_CHECKED(key.chars, 0, &options->moduleArgs, FF_PRINT_TYPE_NO_CUSTOM_KEY, ((FFformatarg[]) {
-                                                                                                     FF_ARG(bios.date, "date"),
-                                                                                                     FF_ARG(bios.release, "release"),
-                                                                                                     FF_ARG(bios.vendor, "vendor"),
-                                                                                                     FF_ARG(bios.version, "version"),
-                                                                                                     FF_ARG(bios.type, "type"),
+                                                                                                     FF_ARG(bios->date, "date"),
+                                                                                                     FF_ARG(bios->release, "release"),
+                                                                                                     FF_ARG(bios->vendor, "vendor"),
+                                                                                                     FF_ARG(bios->version, "version"),
+                                                                                                     FF_ARG(type, "type"),
                                                                                                  }));
     }
-    success = true;
 
-exit:
-    ffStrbufDestroy(&bios.date);
-    ffStrbufDestroy(&bios.release);
-    ffStrbufDestroy(&bios.vendor);
-    ffStrbufDestroy(&bios.version);
-    ffStrbufDestroy(&bios.type);
+    return true;
+}
 
-    return success;
+bool ffPrintBios(FFBiosOptions* options) {
+    return ffModuleResultPrint(&ffBiosModuleInfo, options);
 }
 
 void ffParseBiosJsonObject(FFBiosOptions* options, yyjson_val* module) {
@@ -88,37 +110,24 @@ void ffGenerateBiosJsonConfig(FFBiosOptions* options, yyjson_mut_doc* doc, yyjso
     ffJsonConfigGenerateModuleArgsConfig(doc, module, &options->moduleArgs);
 }
 
-bool ffGenerateBiosJsonResult(FF_A_UNUSED FFBiosOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    bool success = false;
-    FFBiosResult bios;
-    ffStrbufInit(&bios.date);
-    ffStrbufInit(&bios.release);
-    ffStrbufInit(&bios.vendor);
-    ffStrbufInit(&bios.version);
-    ffStrbufInit(&bios.type);
-
-    const char* error = ffDetectBios(&bios);
-
+static bool generateBiosJsonResult(FF_A_UNUSED FFBiosOptions* options, const char* error, FFBiosResult* bios, yyjson_mut_doc* doc, yyjson_mut_val* module) {
     if (error) {
         yyjson_mut_obj_add_str(doc, module, "error", error);
-        goto exit;
+        return false;
     }
 
     yyjson_mut_val* obj = yyjson_mut_obj_add_obj(doc, module, "result");
-    yyjson_mut_obj_add_strbuf(doc, obj, "date", &bios.date);
-    yyjson_mut_obj_add_strbuf(doc, obj, "release", &bios.release);
-    yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &bios.vendor);
-    yyjson_mut_obj_add_strbuf(doc, obj, "version", &bios.version);
-    yyjson_mut_obj_add_strbuf(doc, obj, "type", &bios.type);
-    success = true;
-
-exit:
-    ffStrbufDestroy(&bios.date);
-    ffStrbufDestroy(&bios.release);
-    ffStrbufDestroy(&bios.vendor);
-    ffStrbufDestroy(&bios.version);
-    ffStrbufDestroy(&bios.type);
-    return success;
+    yyjson_mut_obj_add_strbuf(doc, obj, "date", &bios->date);
+    yyjson_mut_obj_add_strbuf(doc, obj, "release", &bios->release);
+    yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &bios->vendor);
+    yyjson_mut_obj_add_strbuf(doc, obj, "version", &bios->version);
+    yyjson_mut_obj_add_strbuf(doc, obj, "type", &bios->type);
+
+    return true;
+}
+
+bool ffGenerateBiosJsonResult(FFBiosOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    return ffModuleResultGenerateJson(&ffBiosModuleInfo, options, doc, module);
 }
 
 void ffInitBiosOptions(FFBiosOptions* options) {
@@ -144,5 +153,17 @@ FFModuleBaseInfo ffBiosModuleInfo = {
         { "BIOS vendor", "vendor" },
         { "BIOS version", "version" },
         { "Firmware type", "type" },
-    }))
+    })),
+    .resultSize = sizeof(FFBiosResult),
+    .detectResult = (void*) detectBiosResult,
+    .destroyResult = (void*) destroyBiosResult,
+    .printResult = (void*) printBiosResult,
+    .generateJsonResultFrom = (void*) generateBiosJsonResult,
+    .cacheKeys = (const FFResultCacheKey[]) {
+        { .type = FF_RESULT_CACHE_KEY_BOOT_ID }, // SMBIOS data doesn't change until reboot
+        {},
+    },
+    .serializeResult = (void*) serializeBiosResult,
+    .deserializeResult = (void*) deserializeBiosResult,
+    .refreshInterval = FF_MODULE_REFRESH_NEVER,
 };
@@ -1,51 +1,77 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
+#include "common/resultcache.h"
 #include "common/strutil.h"
 #include "detection/board/board.h"
 #include "modules/board/board.h"
 
-bool ffPrintBoard(FFBoardOptions* options) {
-    bool success = false;
-    FFBoardResult result;
-    ffStrbufInit(&result.name);
-    ffStrbufInit(&result.vendor);
-    ffStrbufInit(&result.version);
-    ffStrbufInit(&result.serial);
-
-    const char* error = ffDetectBoard(&result);
+static const char* detectBoardResult(FF_A_UNUSED FFBoardOptions* options, FFBoardResult* board) {
+    ffStrbufInit(&board->name);
+    ffStrbufInit(&board->vendor);
+    ffStrbufInit(&board->version);
+    ffStrbufInit(&board->serial);
+
+    const char* error = ffDetectBoard(board);
     if (error) {
-        ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
-        goto exit;
+        return error;
     }
 
-    if (result.name.length == 0) {
-        ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "board_name is not set.");
-        goto exit;
+    if (board->name.length == 0) {
+        return "board_name is not set.";
+    }
+
+    return NULL;
+}
+
+static void destroyBoardResult(FFBoardResult* board) {
+    ffStrbufDestroy(&board->name);
+    ffStrbufDestroy(&board->vendor);
+    ffStrbufDestroy(&board->version);
+    ffStrbufDestroy(&board->serial);
+}
+
+static void serializeBoardResult(FFBoardResult* board, FFstrbuf* data) {
+    ffResultCacheWriteStrbuf(data, &board->name);
+    ffResultCacheWriteStrbuf(data, &board->vendor);
+    ffResultCacheWriteStrbuf(data, &board->version);
+    ffResultCacheWriteStrbuf(data, &board->serial);
+}
+
+static bool deserializeBoardResult(FFBoardResult* board, FFResultCacheReader* reader) {
+    return ffResultCacheReadStrbuf(reader, &board->name) &&
+        ffResultCacheReadStrbuf(reader, &board->vendor) &&
+        ffResultCacheReadStrbuf(reader, &board->version) &&
+        ffResultCacheReadStrbuf(reader, &board->serial);
+}
+
+static bool printBoardResult(FFBoardOptions* options, const char* error, FFBoardResult* board) {
+    if (error) {
+        ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
+        return false;
     }
 
     if (options->moduleArgs.outputFormat.length == 0) {
         ffPrintLogoAndKey(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT);
-        ffStrbufWriteTo(&result.name, stdout);
-        if (result.version.length) {
-            printf(" (%s)", result.version.chars);
+        ffStrbufWriteTo(&board->name, stdout);
+        if (board->version.length) {
+            printf(" (%s)", board->version.chars);
         }
         putchar('\n');
     } else {
         FF_PRINT_FORMAT_CHECKED(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, ((FFformatarg[]) {
-                                                                                                          FF_ARG(result.name, "name"),
-                                                                                                          FF_ARG(result.vendor, "vendor"),
-                                                                                                          FF_ARG(result.version, "version"),
-                                                                                                          FF_ARG(result.serial, "serial"),
+                                                                                                          FF_ARG(board->name, "name"),
+                                                                                                          FF_ARG(board->vendor, "vendor"),
+                                                                                                          FF_ARG(board->version, "version"),
+                                                                                                          FF_ARG(board->serial, "serial"),
                                                                                                       }));
     }
-    success = true;
-
-exit:
-    ffStrbufDestroy(&result.name);
-    ffStrbufDestroy(&result.vendor);
-    ffStrbufDestroy(&result.version);
-    ffStrbufDestroy(&result.serial);
-    return success;
+
+    return true;
+}
+
+bool ffPrintBoard(FFBoardOptions* options) {
+    return ffModuleResultPrint(&ffBoardModuleInfo, options);
 }
 
 void ffParseBoardJsonObject(FFBoardOptions* options, yyjson_val* module) {
@@ -64,39 +90,23 @@ void ffGenerateBoardJsonConfig(FFBoardOptions* options, yyjson_mut_doc* doc, yyj
     ffJsonConfigGenerateModuleArgsConfig(doc, module, &options->moduleArgs);
 }
 
-bool ffGenerateBoardJsonResult(FF_A_UNUSED FFBoardOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    bool success = false;
-    FFBoardResult board;
-    ffStrbufInit(&board.name);
-    ffStrbufInit(&board.vendor);
-    ffStrbufInit(&board.version);
-    ffStrbufInit(&board.serial);
-
-    const char* error = ffDetectBoard(&board);
-
+static bool generateBoardJsonResult(FF_A_UNUSED FFBoardOptions* options, const char* error, FFBoardResult* board, yyjson_mut_doc* doc, yyjson_mut_val* module) {
     if (error) {
         yyjson_mut_obj_add_str(doc, module, "error", error);
-        goto exit;
-    }
-
-    if (board.name.length == 0) {
-        yyjson_mut_obj_add_str(doc, module, "error", "board_name is not set.");
-        goto exit;
+        return false;
     }
 
     yyjson_mut_val* obj = yyjson_mut_obj_add_obj(doc, module, "result");
-    yyjson_mut_obj_add_strbuf(doc, obj, "name", &board.name);
-    yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &board.vendor);
-    yyjson_mut_obj_add_strbuf(doc, obj, "version", &board.version);
-    yyjson_mut_obj_add_strbuf(doc, obj, "serial", &board.serial);
-    success = true;
-
-exit:
-    ffStrbufDestroy(&board.name);
-    ffStrbufDestroy(&board.vendor);
-    ffStrbufDestroy(&board.version);
-    ffStrbufDestroy(&board.serial);
-    return success;
+    yyjson_mut_obj_add_strbuf(doc, obj, "name", &board->name);
+    yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &board->vendor);
+    yyjson_mut_obj_add_strbuf(doc, obj, "version", &board->version);
+    yyjson_mut_obj_add_strbuf(doc, obj, "serial", &board->serial);
+
+    return true;
+}
+
+bool ffGenerateBoardJsonResult(FFBoardOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    return ffModuleResultGenerateJson(&ffBoardModuleInfo, options, doc, module);
 }
 
 void ffInitBoardOptions(FFBoardOptions* options) {
@@ -121,5 +131,17 @@ FFModuleBaseInfo ffBoardModuleInfo = {
         { "Board vendor", "vendor" },
         { "Board version", "version" },
         { "Board serial number", "serial" },
-    }))
+    })),
+    .resultSize = sizeof(FFBoardResult),
+    .detectResult = (void*) detectBoardResult,
+    .destroyResult = (void*) destroyBoardResult,
+    .printResult = (void*) printBoardResult,
+    .generateJsonResultFrom = (void*) generateBoardJsonResult,
+    .cacheKeys = (const FFResultCacheKey[]) {
+        { .type = FF_RESULT_CACHE_KEY_BOOT_ID }, // SMBIOS data doesn't change until reboot
+        {},
+    },
+    .serializeResult = (void*) serializeBoardResult,
+    .deserializeResult = (void*) deserializeBoardResult,
+    .refreshInterval = FF_MODULE_REFRESH_NEVER,
 };
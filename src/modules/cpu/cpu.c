@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
 #include "common/parsing.h"
 #include "common/temps.h"
 #include "common/frequency.h"
@@ -10,111 +11,128 @@ static int sortCores(const FFCPUCore* a, const FFCPUCore* b) {
     return (int) b->freq - (int) a->freq;
 }
 
-bool ffPrintCPU(FFCPUOptions* options) {
-    bool success = false;
-    FFCPUResult cpu = {
-        .temperature = FF_CPU_TEMP_UNSET,
-        .frequencyMax = 0,
-        .frequencyBase = 0,
-        .name = ffStrbufCreate(),
-        .vendor = ffStrbufCreate(),
-    };
+static uint32_t getCPURefreshInterval(FFCPUOptions* options) {
+    return options->temp ? 0 : 10000; // Temperature changes every tick; online cores rarely do
+}
 
-    const char* error = ffDetectCPU(options, &cpu);
+static const char* detectCPUResult(FFCPUOptions* options, FFCPUResult* cpu) {
+    cpu->temperature = FF_CPU_TEMP_UNSET;
+    ffStrbufInit(&cpu->name);
+    ffStrbufInit(&cpu->vendor);
 
+    const char* error = ffDetectCPU(options, cpu);
     if (error) {
-        ffPrintError(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
-    } else if (cpu.vendor.length == 0 && cpu.name.length == 0 && cpu.coresOnline <= 1) {
-        ffPrintError(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "No CPU detected");
-    } else {
-        FF_STRBUF_AUTO_DESTROY coreTypes = ffStrbufCreate();
-        if (options->showPeCoreCount) {
-            uint32_t typeCount = 0;
-            while (cpu.coreTypes[typeCount].count != 0 && typeCount < ARRAY_SIZE(cpu.coreTypes)) {
-                typeCount++;
-            }
-            if (typeCount > 0) {
-                qsort(cpu.coreTypes, typeCount, sizeof(cpu.coreTypes[0]), (void*) sortCores);
+        return error;
+    }
 
-                for (uint32_t i = 0; i < typeCount; i++) {
-                    ffStrbufAppendF(&coreTypes, "%s%u", i == 0 ? "" : "+", cpu.coreTypes[i].count);
-                }
-            }
-        }
+    if (cpu->vendor.length == 0 && cpu->name.length == 0 && cpu->coresOnline <= 1) {
+        return "No CPU detected";
+    }
 
-        if (options->moduleArgs.outputFormat.length == 0) {
-            ffPrintLogoAndKey(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT);
+    return NULL;
+}
 
-            FF_STRBUF_AUTO_DESTROY str = ffStrbufCreate();
+static void destroyCPUResult(FFCPUResult* cpu) {
+    ffStrbufDestroy(&cpu->name);
+    ffStrbufDestroy(&cpu->vendor);
+}
 
-            if (cpu.packages > 1) {
-                ffStrbufAppendF(&str, "%u x ", cpu.packages);
-            }
+static bool printCPUResult(FFCPUOptions* options, const char* error, FFCPUResult* cpu) {
+    if (error) {
+        ffPrintError(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
+        return false;
+    }
 
-            if (cpu.name.length > 0) {
-                ffStrbufAppend(&str, &cpu.name);
-            } else if (cpu.vendor.length > 0) {
-                ffStrbufAppend(&str, &cpu.vendor);
-                ffStrbufAppendS(&str, " CPU");
-            } else {
-                ffStrbufAppendS(&str, "Unknown");
+    FF_STRBUF_AUTO_DESTROY coreTypes = ffStrbufCreate();
+    if (options->showPeCoreCount) {
+        uint32_t typeCount = 0;
+        while (cpu->coreTypes[typeCount].count != 0 && typeCount < ARRAY_SIZE(cpu->coreTypes)) {
+            typeCount++;
+        }
+        if (typeCount > 0) {
+            // `cpu` is shared by other module instances; sort a copy
+            FFCPUCore sortedCoreTypes[sizeof(cpu->coreTypes) / sizeof(cpu->coreTypes[0])];
+            memcpy(sortedCoreTypes, cpu->coreTypes, typeCount * sizeof(cpu->coreTypes[0]));
+            qsort(sortedCoreTypes, typeCount, sizeof(sortedCoreTypes[0]), (void*) sortCores);
+
+            for (uint32_t i = 0; i < typeCount; i++) {
+                ffStrbufAppendF(&coreTypes, "%s%u", i == 0 ? "" : "+", sortedCoreTypes[i].count);
             }
+        }
+    }
 
-            if (coreTypes.length > 0) {
-                ffStrbufAppendF(&str, " (%s)", coreTypes.chars);
-            } else if (cpu.coresOnline > 1) {
-                ffStrbufAppendF(&str, " (%u)", cpu.coresOnline);
-            }
+    if (options->moduleArgs.outputFormat.length == 0) {
+        ffPrintLogoAndKey(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT);
 
-            uint32_t freq = cpu.frequencyMax;
-            if (freq == 0) {
-                freq = cpu.frequencyBase;
-            }
-            if (freq > 0) {
-                ffStrbufAppendS(&str, " @ ");
-                ffFreqAppendNum(freq, &str);
-            }
+        FF_STRBUF_AUTO_DESTROY str = ffStrbufCreate();
 
-            if (cpu.temperature != FF_CPU_TEMP_UNSET) {
-                ffStrbufAppendS(&str, " - ");
-                ffTempsAppendNum(cpu.temperature, &str, options->tempConfig, &options->moduleArgs);
-            }
+        if (cpu->packages > 1) {
+            ffStrbufAppendF(&str, "%u x ", cpu->packages);
+        }
 
-            ffStrbufPutTo(&str, stdout);
+        if (cpu->name.length > 0) {
+            ffStrbufAppend(&str, &cpu->name);
+        } else if (cpu->vendor.length > 0) {
+            ffStrbufAppend(&str, &cpu->vendor);
+            ffStrbufAppendS(&str, " CPU");
         } else {
-            FF_STRBUF_AUTO_DESTROY freqBase = ffStrbufCreate();
-            ffFreqAppendNum(cpu.frequencyBase, &freqBase);
-            FF_STRBUF_AUTO_DESTROY freqMax = ffStrbufCreate();
-            ffFreqAppendNum(cpu.frequencyMax, &freqMax);
-
-            FF_STRBUF_AUTO_DESTROY tempStr = ffStrbufCreate();
-            ffTempsAppendNum(cpu.temperature, &tempStr, options->tempConfig, &options->moduleArgs);
-            FF_PRINT_FORMAT_CHECKED(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, ((FFformatarg[]) {
-                                                                                                            FF_ARG(cpu.name, "name"),
-                                                                                                            FF_ARG(cpu.vendor, "vendor"),
-                                                                                                            FF_ARG(cpu.coresPhysical, "cores-physical"),
-                                                                                                            FF_ARG(cpu.coresLogical, "cores-logical"),
-                                                                                                            FF_ARG(cpu.coresOnline, "cores-online"),
-                                                                                                            FF_ARG(freqBase, "freq-base"),
-                                                                                                            FF_ARG(freqMax, "freq-max"),
-                                                                                                            FF_ARG(tempStr, "temperature"),
-                                                                                                            FF_ARG(coreTypes, "core-types"),
-                                                                                                            FF_ARG(cpu.packages, "packages"),
-                                                                                                            FF_ARG(cpu.march, "march"),
-                                                                                                            FF_ARG(cpu.numaNodes, "numa-nodes"),
-                                                                                                            #if __i386__ || __x86_64__
-                                                                                                            FF_ARG(cpu.codeName, "code-name"),
-                                                                                                            FF_ARG(cpu.technology, "technology"),
-                                                                                                            #endif
-                                                                                                        }));
+            ffStrbufAppendS(&str, "Unknown");
+        }
+
+        if (coreTypes.length > 0) {
+            ffStrbufAppendF(&str, " (%s)", coreTypes.chars);
+        } else if (cpu->coresOnline > 1) {
+            ffStrbufAppendF(&str, " (%u)", cpu->coresOnline);
         }
-        success = true;
+
+        uint32_t freq = cpu->frequencyMax;
+        if (freq == 0) {
+            freq = cpu->frequencyBase;
+        }
+        if (freq > 0) {
+            ffStrbufAppendS(&str, " @ ");
+            ffFreqAppendNum(freq, &str);
+        }
+
+        if (cpu->temperature != FF_CPU_TEMP_UNSET) {
+            ffStrbufAppendS(&str, " - ");
+            ffTempsAppendNum(cpu->temperature, &str, options->tempConfig, &options->moduleArgs);
+        }
+
+        ffStrbufPutTo(&str, stdout);
+    } else {
+        FF_STRBUF_AUTO_DESTROY freqBase = ffStrbufCreate();
+        ffFreqAppendNum(cpu->frequencyBase, &freqBase);
+        FF_STRBUF_AUTO_DESTROY freqMax = ffStrbufCreate();
+        ffFreqAppendNum(cpu->frequencyMax, &freqMax);
+
+        FF_STRBUF_AUTO_DESTROY tempStr = ffStrbufCreate();
+        ffTempsAppendNum(cpu->temperature, &tempStr, options->tempConfig, &options->moduleArgs);
+        FF_PRINT_FORMAT_CHECKED(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, ((FFformatarg[]) {
+                                                                                                        FF_ARG(cpu->name, "name"),
+                                                                                                        FF_ARG(cpu->vendor, "vendor"),
+                                                                                                        FF_ARG(cpu->coresPhysical, "cores-physical"),
+                                                                                                        FF_ARG(cpu->coresLogical, "cores-logical"),
+                                                                                                        FF_ARG(cpu->coresOnline, "cores-online"),
+                                                                                                        FF_ARG(freqBase, "freq-base"),
+                                                                                                        FF_ARG(freqMax, "freq-max"),
+                                                                                                        FF_ARG(tempStr, "temperature"),
+                                                                                                        FF_ARG(coreTypes, "core-types"),
+                                                                                                        FF_ARG(cpu->packages, "packages"),
+                                                                                                        FF_ARG(cpu->march, "march"),
+                                                                                                        FF_ARG(cpu->numaNodes, "numa-nodes"),
+                                                                                                        #if __i386__ || __x86_64__
+                                                                                                        FF_ARG(cpu->codeName, "code-name"),
+                                                                                                        FF_ARG(cpu->technology, "technology"),
+                                                                                                        #endif
+                                                                                                    }));
     }
 
-    ffStrbufDestroy(&cpu.name);
-    ffStrbufDestroy(&cpu.vendor);
+    return true;
+}
 
-    return success;
+bool ffPrintCPU(FFCPUOptions* options) {
+    return ffModuleResultPrint(&ffCPUModuleInfo, options);
 }
 
 void ffParseCPUJsonObject(FFCPUOptions* options, yyjson_val* module) {
@@ -158,87 +176,74 @@ void ffGenerateCPUJsonConfig(FFCPUOptions* options, yyjson_mut_doc* doc, yyjson_
     yyjson_mut_obj_add_strbuf(doc, module, "tempSensor", &options->tempSensor);
 }
 
-bool ffGenerateCPUJsonResult(FFCPUOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    bool success = false;
-    FFCPUResult cpu = {
-        .temperature = FF_CPU_TEMP_UNSET,
-        .frequencyMax = 0,
-        .frequencyBase = 0,
-        .name = ffStrbufCreate(),
-        .vendor = ffStrbufCreate(),
-    };
-
-    const char* error = ffDetectCPU(options, &cpu);
-
+static bool generateCPUJsonResult(FF_A_UNUSED FFCPUOptions* options, const char* error, FFCPUResult* cpu, yyjson_mut_doc* doc, yyjson_mut_val* module) {
     if (error) {
         yyjson_mut_obj_add_str(doc, module, "error", error);
-    } else if (cpu.vendor.length == 0 && cpu.name.length == 0 && cpu.coresOnline <= 1) {
-        yyjson_mut_obj_add_str(doc, module, "error", "No CPU detected");
+        return false;
+    }
+
+    yyjson_mut_val* obj = yyjson_mut_obj_add_obj(doc, module, "result");
+    yyjson_mut_obj_add_strbuf(doc, obj, "cpu", &cpu->name);
+    yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &cpu->vendor);
+    if (cpu->packages == 0) {
+        yyjson_mut_obj_add_null(doc, obj, "packages");
     } else {
-        yyjson_mut_val* obj = yyjson_mut_obj_add_obj(doc, module, "result");
-        yyjson_mut_obj_add_strbuf(doc, obj, "cpu", &cpu.name);
-        yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &cpu.vendor);
-        if (cpu.packages == 0) {
-            yyjson_mut_obj_add_null(doc, obj, "packages");
-        } else {
-            yyjson_mut_obj_add_uint(doc, obj, "packages", cpu.packages);
-        }
+        yyjson_mut_obj_add_uint(doc, obj, "packages", cpu->packages);
+    }
 
-        yyjson_mut_val* cores = yyjson_mut_obj_add_obj(doc, obj, "cores");
-        yyjson_mut_obj_add_uint(doc, cores, "physical", cpu.coresPhysical);
-        yyjson_mut_obj_add_uint(doc, cores, "logical", cpu.coresLogical);
-        yyjson_mut_obj_add_uint(doc, cores, "online", cpu.coresOnline);
+    yyjson_mut_val* cores = yyjson_mut_obj_add_obj(doc, obj, "cores");
+    yyjson_mut_obj_add_uint(doc, cores, "physical", cpu->coresPhysical);
+    yyjson_mut_obj_add_uint(doc, cores, "logical", cpu->coresLogical);
+    yyjson_mut_obj_add_uint(doc, cores, "online", cpu->coresOnline);
 
-        yyjson_mut_val* frequency = yyjson_mut_obj_add_obj(doc, obj, "frequency");
-        yyjson_mut_obj_add_uint(doc, frequency, "base", cpu.frequencyBase);
-        yyjson_mut_obj_add_uint(doc, frequency, "max", cpu.frequencyMax);
+    yyjson_mut_val* frequency = yyjson_mut_obj_add_obj(doc, obj, "frequency");
+    yyjson_mut_obj_add_uint(doc, frequency, "base", cpu->frequencyBase);
+    yyjson_mut_obj_add_uint(doc, frequency, "max", cpu->frequencyMax);
 
-        yyjson_mut_val* coreTypes = yyjson_mut_obj_add_arr(doc, obj, "coreTypes");
-        for (uint32_t i = 0; i < ARRAY_SIZE(cpu.coreTypes) && cpu.coreTypes[i].count > 0; i++) {
-            yyjson_mut_val* core = yyjson_mut_arr_add_obj(doc, coreTypes);
-            yyjson_mut_obj_add_uint(doc, core, "count", cpu.coreTypes[i].count);
-            yyjson_mut_obj_add_uint(doc, core, "freq", cpu.coreTypes[i].freq);
-        }
-
-        if (cpu.temperature != FF_CPU_TEMP_UNSET) {
-            yyjson_mut_obj_add_real(doc, obj, "temperature", cpu.temperature);
-        } else {
-            yyjson_mut_obj_add_null(doc, obj, "temperature");
-        }
+    yyjson_mut_val* coreTypes = yyjson_mut_obj_add_arr(doc, obj, "coreTypes");
+    for (uint32_t i = 0; i < ARRAY_SIZE(cpu->coreTypes) && cpu->coreTypes[i].count > 0; i++) {
+        yyjson_mut_val* core = yyjson_mut_arr_add_obj(doc, coreTypes);
+        yyjson_mut_obj_add_uint(doc, core, "count", cpu->coreTypes[i].count);
+        yyjson_mut_obj_add_uint(doc, core, "freq", cpu->coreTypes[i].freq);
+    }
 
-        if (cpu.march) {
-            yyjson_mut_obj_add_str(doc, obj, "march", cpu.march);
-        } else {
-            yyjson_mut_obj_add_null(doc, obj, "march");
-        }
+    if (cpu->temperature != FF_CPU_TEMP_UNSET) {
+        yyjson_mut_obj_add_real(doc, obj, "temperature", cpu->temperature);
+    } else {
+        yyjson_mut_obj_add_null(doc, obj, "temperature");
+    }
 
-        if (cpu.numaNodes > 0) {
-            yyjson_mut_obj_add_uint(doc, obj, "numaNodes", cpu.numaNodes);
-        } else {
-            yyjson_mut_obj_add_null(doc, obj, "numaNodes");
-        }
+    if (cpu->march) {
+        yyjson_mut_obj_add_str(doc, obj, "march", cpu->march);
+    } else {
+        yyjson_mut_obj_add_null(doc, obj, "march");
+    }
 
-        #if __i386__ || __x86_64__
-        if (cpu.codeName) {
-            yyjson_mut_obj_add_str(doc, obj, "codeName", cpu.codeName);
-        } else {
-            yyjson_mut_obj_add_null(doc, obj, "codeName");
-        }
+    if (cpu->numaNodes > 0) {
+        yyjson_mut_obj_add_uint(doc, obj, "numaNodes", cpu->numaNodes);
+    } else {
+        yyjson_mut_obj_add_null(doc, obj, "numaNodes");
+    }
 
-        if (cpu.technology) {
-            yyjson_mut_obj_add_str(doc, obj, "technology", cpu.technology);
-        } else {
-            yyjson_mut_obj_add_null(doc, obj, "technology");
-        }
-        #endif
+    #if __i386__ || __x86_64__
+    if (cpu->codeName) {
+        yyjson_mut_obj_add_str(doc, obj, "codeName", cpu->codeName);
+    } else {
+        yyjson_mut_obj_add_null(doc, obj, "codeName");
+    }
 
-        success = true;
+    if (cpu->technology) {
+        yyjson_mut_obj_add_str(doc, obj, "technology", cpu->technology);
+    } else {
+        yyjson_mut_obj_add_null(doc, obj, "technology");
     }
+    #endif
 
-    ffStrbufDestroy(&cpu.name);
-    ffStrbufDestroy(&cpu.vendor);
+    return true;
+}
 
-    return success;
+bool ffGenerateCPUJsonResult(FFCPUOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    return ffModuleResultGenerateJson(&ffCPUModuleInfo, options, doc, module);
 }
 
 void ffInitCPUOptions(FFCPUOptions* options) {
@@ -280,5 +285,11 @@ FFModuleBaseInfo ffCPUModuleInfo = {
         { "CPU code name", "code-name" },
         { "CPU technology", "technology" },
         #endif
-    }))
+    })),
+    .resultSize = sizeof(FFCPUResult),
+    .detectResult = (void*) detectCPUResult,
+    .destroyResult = (void*) destroyCPUResult,
+    .printResult = (void*) printCPUResult,
+    .generateJsonResultFrom = (void*) generateCPUJsonResult,
+    .getRefreshInterval = (void*) getCPURefreshInterval,
 };
@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
 #include "common/percent.h"
 #include "common/size.h"
 #include "common/time.h"
@@ -76,6 +77,8 @@ static void printDisk(FFDiskOptions* options, const FFDisk* disk, uint32_t index
                 ffPercentAppendNum(&str, bytesPercentage, options->percent, str.length > 0, &options->moduleArgs);
                 ffStrbufAppendC(&str, ' ');
             }
+        } else if (disk->type & FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT) {
+            ffStrbufAppendS(&str, "Unresponsive ");
         } else {
             ffStrbufAppendS(&str, "Unknown ");
         }
@@ -182,22 +185,34 @@ static void printDisk(FFDiskOptions* options, const FFDisk* disk, uint32_t index
     }
 }
 
-bool ffPrintDisk(FFDiskOptions* options) {
-    FF_LIST_AUTO_DESTROY disks = ffListCreate();
-    const char* error = ffDetectDisks(options, &disks);
+static const char* detectDiskResult(FFDiskOptions* options, FFlist* disks) {
+    ffListInit(disks);
+    return ffDetectDisks(options, disks);
+}
+
+static void destroyDiskResult(FFlist* disks) {
+    FF_LIST_FOR_EACH (FFDisk, disk, *disks) {
+        ffStrbufDestroy(&disk->mountFrom);
+        ffStrbufDestroy(&disk->mountpoint);
+        ffStrbufDestroy(&disk->filesystem);
+        ffStrbufDestroy(&disk->name);
+    }
+    ffListDestroy(disks);
+}
 
+static bool printDiskResult(FFDiskOptions* options, const char* error, FFlist* disks) {
     if (error) {
         ffPrintError(FF_DISK_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
         return false;
     }
 
-    if (disks.length == 0) {
+    if (disks->length == 0) {
         ffPrintError(FF_DISK_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "No disks found");
         return false;
     }
 
     uint32_t index = 0;
-    FF_LIST_FOR_EACH (FFDisk, disk, disks) {
+    FF_LIST_FOR_EACH (FFDisk, disk, *disks) {
         if (__builtin_expect(options->folders.length == 0, 1) && (disk->type & ~options->showTypes)) {
             continue;
         }
@@ -205,16 +220,13 @@ bool ffPrintDisk(FFDiskOptions* options) {
         printDisk(options, disk, ++index);
     }
 
-    FF_LIST_FOR_EACH (FFDisk, disk, disks) {
-        ffStrbufDestroy(&disk->mountFrom);
-        ffStrbufDestroy(&disk->mountpoint);
-        ffStrbufDestroy(&disk->filesystem);
-        ffStrbufDestroy(&disk->name);
-    }
-
     return true;
 }
 
+bool ffPrintDisk(FFDiskOptions* options) {
+    return ffModuleResultPrint(&ffDiskModuleInfo, options);
+}
+
 static bool setSeparatedList(FFstrbuf* strbuf, yyjson_val* val, char separator) {
     if (yyjson_is_str(val)) {
         ffStrbufSetJsonVal(strbuf, val);
@@ -314,6 +326,20 @@ void ffParseDiskJsonObject(FFDiskOptions* options, yyjson_val* module) {
             continue;
         }
 
+        if (unsafe_yyjson_equals_str(key, "showUnresponsive")) {
+            if (yyjson_get_bool(val)) {
+                options->showTypes |= FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT;
+            } else {
+                options->showTypes &= ~FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT;
+            }
+            continue;
+        }
+
+        if (unsafe_yyjson_equals_str(key, "timeout")) {
+            options->timeout = (uint32_t) yyjson_get_uint(val);
+            continue;
+        }
+
         if (unsafe_yyjson_equals_str(key, "useAvailable")) {
             if (yyjson_get_bool(val)) {
                 options->calcType = FF_DISK_CALC_TYPE_AVAILABLE;
@@ -346,6 +372,8 @@ void ffGenerateDiskJsonConfig(FFDiskOptions* options, yyjson_mut_doc* doc, yyjso
 
     yyjson_mut_obj_add_bool(doc, module, "showUnknown", !!(options->showTypes & FF_DISK_VOLUME_TYPE_UNKNOWN_BIT));
 
+    yyjson_mut_obj_add_bool(doc, module, "showUnresponsive", !!(options->showTypes & FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT));
+
     yyjson_mut_obj_add_strbuf(doc, module, "folders", &options->folders);
 
     yyjson_mut_obj_add_strbuf(doc, module, "hideFolders", &options->hideFolders);
@@ -354,13 +382,12 @@ void ffGenerateDiskJsonConfig(FFDiskOptions* options, yyjson_mut_doc* doc, yyjso
 
     yyjson_mut_obj_add_bool(doc, module, "useAvailable", options->calcType == FF_DISK_CALC_TYPE_AVAILABLE);
 
+    yyjson_mut_obj_add_uint(doc, module, "timeout", options->timeout);
+
     ffPercentGenerateJsonConfig(doc, module, options->percent);
 }
 
-bool ffGenerateDiskJsonResult(FFDiskOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    FF_LIST_AUTO_DESTROY disks = ffListCreate();
-    const char* error = ffDetectDisks(options, &disks);
-
+static bool generateDiskJsonResult(FF_A_UNUSED FFDiskOptions* options, const char* error, FFlist* disks, yyjson_mut_doc* doc, yyjson_mut_val* module) {
     if (error) {
         yyjson_mut_obj_add_str(doc, module, "error", error);
         return false;
@@ -368,7 +395,7 @@ bool ffGenerateDiskJsonResult(FFDiskOptions* options, yyjson_mut_doc* doc, yyjso
 
     yyjson_mut_val* arr = yyjson_mut_obj_add_arr(doc, module, "result");
 
-    FF_LIST_FOR_EACH (FFDisk, item, disks) {
+    FF_LIST_FOR_EACH (FFDisk, item, *disks) {
         yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
 
         yyjson_mut_val* bytes = yyjson_mut_obj_add_obj(doc, obj, "bytes");
@@ -409,6 +436,9 @@ bool ffGenerateDiskJsonResult(FFDiskOptions* options, yyjson_mut_doc* doc, yyjso
         if (item->type & FF_DISK_VOLUME_TYPE_UNKNOWN_BIT) {
             yyjson_mut_arr_add_str(doc, typeArr, "Unknown");
         }
+        if (item->type & FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT) {
+            yyjson_mut_arr_add_str(doc, typeArr, "Unresponsive");
+        }
 
         const char* pstr = ffTimeToFullStr(item->createTime);
         if (*pstr) {
@@ -418,16 +448,13 @@ bool ffGenerateDiskJsonResult(FFDiskOptions* options, yyjson_mut_doc* doc, yyjso
         }
     }
 
-    FF_LIST_FOR_EACH (FFDisk, item, disks) {
-        ffStrbufDestroy(&item->mountpoint);
-        ffStrbufDestroy(&item->mountFrom);
-        ffStrbufDestroy(&item->filesystem);
-        ffStrbufDestroy(&item->name);
-    }
-
     return true;
 }
 
+bool ffGenerateDiskJsonResult(FFDiskOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    return ffModuleResultGenerateJson(&ffDiskModuleInfo, options, doc, module);
+}
+
 void ffInitDiskOptions(FFDiskOptions* options) {
     ffOptionInitModuleArg(&options->moduleArgs, "");
 
@@ -438,8 +465,9 @@ void ffInitDiskOptions(FFDiskOptions* options) {
     ffStrbufInitS(&options->hideFolders, "/efi:/boot:/boot/*");
 #endif
     ffStrbufInit(&options->hideFS);
-    options->showTypes = FF_DISK_VOLUME_TYPE_REGULAR_BIT | FF_DISK_VOLUME_TYPE_EXTERNAL_BIT | FF_DISK_VOLUME_TYPE_READONLY_BIT;
+    options->showTypes = FF_DISK_VOLUME_TYPE_REGULAR_BIT | FF_DISK_VOLUME_TYPE_EXTERNAL_BIT | FF_DISK_VOLUME_TYPE_READONLY_BIT | FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT;
     options->calcType = FF_DISK_CALC_TYPE_FREE;
+    options->timeout = 1000;
     options->percent = (FFPercentageModuleConfig) { 50, 80, 0 };
 }
 
@@ -486,5 +514,11 @@ FFModuleBaseInfo ffDiskModuleInfo = {
         { "Years fraction after creation", "years-fraction" },
         { "Size free", "size-free" },
         { "Size available", "size-available" },
-    }))
+    })),
+    .resultSize = sizeof(FFlist),
+    .detectResult = (void*) detectDiskResult,
+    .destroyResult = (void*) destroyDiskResult,
+    .printResult = (void*) printDiskResult,
+    .generateJsonResultFrom = (void*) generateDiskJsonResult,
+    .refreshInterval = 10000, // Disk usage
 };
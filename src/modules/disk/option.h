@@ -11,6 +11,7 @@ typedef enum FF_A_PACKED FFDiskVolumeType {
     FF_DISK_VOLUME_TYPE_SUBVOLUME_BIT = 1 << 3,
     FF_DISK_VOLUME_TYPE_UNKNOWN_BIT = 1 << 4,
     FF_DISK_VOLUME_TYPE_READONLY_BIT = 1 << 5,
+    FF_DISK_VOLUME_TYPE_UNRESPONSIVE_BIT = 1 << 6,
     FF_DISK_VOLUME_TYPE_FORCE_UNSIGNED = UINT8_MAX,
 } FFDiskVolumeType;
 
@@ -27,6 +28,7 @@ typedef struct FFDiskOptions {
     FFstrbuf hideFS;
     FFDiskVolumeType showTypes;
     FFDiskCalcType calcType;
+    uint32_t timeout;
     FFPercentageModuleConfig percent;
 } FFDiskOptions;
 
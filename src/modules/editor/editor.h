@@ -4,6 +4,7 @@
 
 #define FF_EDITOR_MODULE_NAME "Editor"
 
+void ffPrepareEditor(void);
 bool ffPrintEditor(FFEditorOptions* options);
 void ffInitEditorOptions(FFEditorOptions* options);
 void ffDestroyEditorOptions(FFEditorOptions* options);
@@ -1,6 +1,7 @@
 #include "common/percent.h"
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
 #include "common/temps.h"
 #include "common/size.h"
 #include "common/frequency.h"
@@ -11,7 +12,7 @@
 
 #include <stdlib.h>
 
-static void printGPUResult(FFGPUOptions* options, uint8_t index, const FFGPUResult* gpu) {
+static void printGPU(FFGPUOptions* options, uint8_t index, const FFGPUResult* gpu) {
     const char* type;
     switch (gpu->type) {
         case FF_GPU_TYPE_INTEGRATED:
@@ -172,17 +173,36 @@ static void printGPUResult(FFGPUOptions* options, uint8_t index, const FFGPUResu
     }
 }
 
-bool ffPrintGPU(FFGPUOptions* options) {
-    FF_LIST_AUTO_DESTROY gpus = ffListCreate();
-    const char* error = ffDetectGPU(options, &gpus);
+static uint32_t getGPURefreshInterval(FFGPUOptions* options) {
+    // Temperature, and with driver specific detection memory usage, core usage and frequency change every tick
+    return options->temp || options->driverSpecific ? 0 : 10000;
+}
+
+static const char* detectGPUResult(FFGPUOptions* options, FFlist* gpus) {
+    ffListInit(gpus);
+    return ffDetectGPU(options, gpus);
+}
+
+static void destroyGPUResult(FFlist* gpus) {
+    FF_LIST_FOR_EACH (FFGPUResult, gpu, *gpus) {
+        ffStrbufDestroy(&gpu->vendor);
+        ffStrbufDestroy(&gpu->name);
+        ffStrbufDestroy(&gpu->driver);
+        ffStrbufDestroy(&gpu->platformApi);
+        ffStrbufDestroy(&gpu->memoryType);
+    }
+    ffListDestroy(gpus);
+}
+
+static bool printGPUResult(FFGPUOptions* options, const char* error, FFlist* gpus) {
     if (error) {
         ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
         return false;
     }
 
-    FF_LIST_AUTO_DESTROY selectedGPUs = ffListCreateA(sizeof(const FFGPUResult*), gpus.length);
+    FF_LIST_AUTO_DESTROY selectedGPUs = ffListCreateA(sizeof(const FFGPUResult*), gpus->length);
 
-    FF_LIST_FOR_EACH (FFGPUResult, gpu, gpus) {
+    FF_LIST_FOR_EACH (FFGPUResult, gpu, *gpus) {
         if (gpu->type == FF_GPU_TYPE_UNKNOWN && options->hideType == FF_GPU_TYPE_UNKNOWN) {
             continue;
         }
@@ -200,26 +220,22 @@ bool ffPrintGPU(FFGPUOptions* options) {
 
     uint32_t i = 0;
     FF_LIST_FOR_EACH (const FFGPUResult*, pgpu, selectedGPUs) {
-        printGPUResult(options, selectedGPUs.length == 1 ? 0 : (uint8_t) (i + 1), *pgpu);
+        printGPU(options, selectedGPUs.length == 1 ? 0 : (uint8_t) (i + 1), *pgpu);
         ++i;
     }
 
-    FF_LIST_FOR_EACH (FFGPUResult, gpu, gpus) {
-        ffStrbufDestroy(&gpu->vendor);
-        ffStrbufDestroy(&gpu->name);
-        ffStrbufDestroy(&gpu->driver);
-        ffStrbufDestroy(&gpu->platformApi);
-        ffStrbufDestroy(&gpu->memoryType);
-    }
-
     if (selectedGPUs.length == 0) {
-        ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, (gpus.length > 0 ? "GPUs found but all hidden by hideType option" : "No GPUs detected"));
+        ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, (gpus->length > 0 ? "GPUs found but all hidden by hideType option" : "No GPUs detected"));
         return false;
     }
 
     return true;
 }
 
+bool ffPrintGPU(FFGPUOptions* options) {
+    return ffModuleResultPrint(&ffGPUModuleInfo, options);
+}
+
 void ffParseGPUJsonObject(FFGPUOptions* options, yyjson_val* module) {
     yyjson_val *key, *val;
     size_t idx, max;
@@ -331,16 +347,14 @@ void ffGenerateGPUJsonConfig(FFGPUOptions* options, yyjson_mut_doc* doc, yyjson_
     ffPercentGenerateJsonConfig(doc, module, options->percent);
 }
 
-bool ffGenerateGPUJsonResult(FFGPUOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    FF_LIST_AUTO_DESTROY gpus = ffListCreate();
-    const char* error = ffDetectGPU(options, &gpus);
+static bool generateGPUJsonResult(FF_A_UNUSED FFGPUOptions* options, const char* error, FFlist* gpus, yyjson_mut_doc* doc, yyjson_mut_val* module) {
     if (error) {
         yyjson_mut_obj_add_str(doc, module, "error", error);
         return false;
     }
 
     yyjson_mut_val* arr = yyjson_mut_obj_add_arr(doc, module, "result");
-    FF_LIST_FOR_EACH (FFGPUResult, gpu, gpus) {
+    FF_LIST_FOR_EACH (FFGPUResult, gpu, *gpus) {
         yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
 
         if (gpu->index != FF_GPU_INDEX_UNSET) {
@@ -446,17 +460,13 @@ bool ffGenerateGPUJsonResult(FFGPUOptions* options, yyjson_mut_doc* doc, yyjson_
         }
     }
 
-    FF_LIST_FOR_EACH (FFGPUResult, gpu, gpus) {
-        ffStrbufDestroy(&gpu->vendor);
-        ffStrbufDestroy(&gpu->name);
-        ffStrbufDestroy(&gpu->driver);
-        ffStrbufDestroy(&gpu->platformApi);
-        ffStrbufDestroy(&gpu->memoryType);
-    }
-
     return true;
 }
 
+bool ffGenerateGPUJsonResult(FFGPUOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    return ffModuleResultGenerateJson(&ffGPUModuleInfo, options, doc, module);
+}
+
 void ffInitGPUOptions(FFGPUOptions* options) {
     ffOptionInitModuleArg(&options->moduleArgs, "󰾲");
 
@@ -511,4 +521,10 @@ FFModuleBaseInfo ffGPUModuleInfo = {
         { "PCIe maximum speed in gen and lanes", "pcie-max-speed" },
         { "PCIe current speed in gen and lanes", "pcie-curr-speed" },
     })),
+    .resultSize = sizeof(FFlist),
+    .detectResult = (void*) detectGPUResult,
+    .destroyResult = (void*) destroyGPUResult,
+    .printResult = (void*) printGPUResult,
+    .generateJsonResultFrom = (void*) generateGPUJsonResult,
+    .getRefreshInterval = (void*) getGPURefreshInterval,
 };
@@ -1,29 +1,66 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
+#include "common/resultcache.h"
 #include "common/strutil.h"
 #include "detection/host/host.h"
 #include "modules/host/host.h"
 
-bool ffPrintHost(FFHostOptions* options) {
-    bool success = false;
-    FFHostResult host;
-    ffStrbufInit(&host.family);
-    ffStrbufInit(&host.name);
-    ffStrbufInit(&host.version);
-    ffStrbufInit(&host.sku);
-    ffStrbufInit(&host.serial);
-    ffStrbufInit(&host.uuid);
-    ffStrbufInit(&host.vendor);
-
-    const char* error = ffDetectHost(&host);
+static const char* detectHostResult(FF_A_UNUSED FFHostOptions* options, FFHostResult* host) {
+    ffStrbufInit(&host->family);
+    ffStrbufInit(&host->name);
+    ffStrbufInit(&host->version);
+    ffStrbufInit(&host->sku);
+    ffStrbufInit(&host->serial);
+    ffStrbufInit(&host->uuid);
+    ffStrbufInit(&host->vendor);
+
+    const char* error = ffDetectHost(host);
     if (error) {
-        ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
-        goto exit;
+        return error;
     }
 
-    if (host.name.length == 0 && host.family.length == 0) {
-        ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "neither product_family nor product_name is set by O.E.M.");
-        goto exit;
+    if (host->name.length == 0 && host->family.length == 0) {
+        return "neither product_family nor product_name is set by O.E.M.";
+    }
+
+    return NULL;
+}
+
+static void destroyHostResult(FFHostResult* host) {
+    ffStrbufDestroy(&host->family);
+    ffStrbufDestroy(&host->name);
+    ffStrbufDestroy(&host->version);
+    ffStrbufDestroy(&host->sku);
+    ffStrbufDestroy(&host->serial);
+    ffStrbufDestroy(&host->uuid);
+    ffStrbufDestroy(&host->vendor);
+}
+
+static void serializeHostResult(FFHostResult* host, FFstrbuf* data) {
+    ffResultCacheWriteStrbuf(data, &host->family);
+    ffResultCacheWriteStrbuf(data, &host->name);
+    ffResultCacheWriteStrbuf(data, &host->version);
+    ffResultCacheWriteStrbuf(data, &host->sku);
+    ffResultCacheWriteStrbuf(data, &host->serial);
+    ffResultCacheWriteStrbuf(data, &host->uuid);
+    ffResultCacheWriteStrbuf(data, &host->vendor);
+}
+
+static bool deserializeHostResult(FFHostResult* host, FFResultCacheReader* reader) {
+    return ffResultCacheReadStrbuf(reader, &host->family) &&
+        ffResultCacheReadStrbuf(reader, &host->name) &&
+        ffResultCacheReadStrbuf(reader, &host->version) &&
+        ffResultCacheReadStrbuf(reader, &host->sku) &&
+        ffResultCacheReadStrbuf(reader, &host->serial) &&
+        ffResultCacheReadStrbuf(reader, &host->uuid) &&
+        ffResultCacheReadStrbuf(reader, &host->vendor);
+}
+
+static bool printHostResult(FFHostOptions* options, const char* error, FFHostResult* host) {
+    if (error) {
+        ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
+        return false;
     }
 
     if (options->moduleArgs.outputFormat.length == 0) {
@@ -31,40 +68,34 @@ bool ffPrintHost(FFHostOptions* options) {
 
         FF_STRBUF_AUTO_DESTROY output = ffStrbufCreate();
 
-        if (host.name.length > 0) {
-            ffStrbufAppend(&output, &host.name);
+        if (host->name.length > 0) {
+            ffStrbufAppend(&output, &host->name);
         } else {
-            ffStrbufAppend(&output, &host.family);
+            ffStrbufAppend(&output, &host->family);
         }
 
-        if (host.version.length > 0) {
-            ffStrbufAppendF(&output, " (%s)", host.version.chars);
+        if (host->version.length > 0) {
+            ffStrbufAppendF(&output, " (%s)", host->version.chars);
         }
 
         ffStrbufPutTo(&output, stdout);
     } else {
         FF_PRINT_FORMAT_CHECKED(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, ((FFformatarg[]) {
-                                                                                                         FF_ARG(host.family, "family"),
-                                                                                                         FF_ARG(host.name, "name"),
-                                                                                                         FF_ARG(host.version, "version"),
-                                                                                                         FF_ARG(host.sku, "sku"),
-                                                                                                         FF_ARG(host.vendor, "vendor"),
-                                                                                                         FF_ARG(host.serial, "serial"),
-                                                                                                         FF_ARG(host.uuid, "uuid"),
+                                                                                                         FF_ARG(host->family, "family"),
+                                                                                                         FF_ARG(host->name, "name"),
+                                                                                                         FF_ARG(host->version, "version"),
+                                                                                                         FF_ARG(host->sku, "sku"),
+                                                                                                         FF_ARG(host->vendor, "vendor"),
+                                                                                                         FF_ARG(host->serial, "serial"),
+                                                                                                         FF_ARG(host->uuid, "uuid"),
                                                                                                      }));
     }
-    success = true;
-
-exit:
-    ffStrbufDestroy(&host.family);
-    ffStrbufDestroy(&host.name);
-    ffStrbufDestroy(&host.version);
-    ffStrbufDestroy(&host.sku);
-    ffStrbufDestroy(&host.serial);
-    ffStrbufDestroy(&host.uuid);
-    ffStrbufDestroy(&host.vendor);
-
-    return success;
+
+    return true;
+}
+
+bool ffPrintHost(FFHostOptions* options) {
+    return ffModuleResultPrint(&ffHostModuleInfo, options);
 }
 
 void ffParseHostJsonObject(FFHostOptions* options, yyjson_val* module) {
@@ -83,48 +114,26 @@ void ffGenerateHostJsonConfig(FFHostOptions* options, yyjson_mut_doc* doc, yyjso
     ffJsonConfigGenerateModuleArgsConfig(doc, module, &options->moduleArgs);
 }
 
-bool ffGenerateHostJsonResult(FF_A_UNUSED FFHostOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    bool success = false;
-    FFHostResult host;
-    ffStrbufInit(&host.family);
-    ffStrbufInit(&host.name);
-    ffStrbufInit(&host.version);
-    ffStrbufInit(&host.sku);
-    ffStrbufInit(&host.serial);
-    ffStrbufInit(&host.uuid);
-    ffStrbufInit(&host.vendor);
-
-    const char* error = ffDetectHost(&host);
+static bool generateHostJsonResult(FF_A_UNUSED FFHostOptions* options, const char* error, FFHostResult* host, yyjson_mut_doc* doc, yyjson_mut_val* module) {
     if (error) {
         yyjson_mut_obj_add_str(doc, module, "error", error);
-        goto exit;
-    }
-
-    if (host.family.length == 0 && host.name.length == 0) {
-        yyjson_mut_obj_add_str(doc, module, "error", "neither product_family nor product_name is set by O.E.M.");
-        goto exit;
+        return false;
     }
 
     yyjson_mut_val* obj = yyjson_mut_obj_add_obj(doc, module, "result");
-    yyjson_mut_obj_add_strbuf(doc, obj, "family", &host.family);
-    yyjson_mut_obj_add_strbuf(doc, obj, "name", &host.name);
-    yyjson_mut_obj_add_strbuf(doc, obj, "version", &host.version);
-    yyjson_mut_obj_add_strbuf(doc, obj, "sku", &host.sku);
-    yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &host.vendor);
-    yyjson_mut_obj_add_strbuf(doc, obj, "serial", &host.serial);
-    yyjson_mut_obj_add_strbuf(doc, obj, "uuid", &host.uuid);
-    success = true;
-
-exit:
-    ffStrbufDestroy(&host.family);
-    ffStrbufDestroy(&host.name);
-    ffStrbufDestroy(&host.version);
-    ffStrbufDestroy(&host.sku);
-    ffStrbufDestroy(&host.serial);
-    ffStrbufDestroy(&host.uuid);
-    ffStrbufDestroy(&host.vendor);
-
-    return success;
+    yyjson_mut_obj_add_strbuf(doc, obj, "family", &host->family);
+    yyjson_mut_obj_add_strbuf(doc, obj, "name", &host->name);
+    yyjson_mut_obj_add_strbuf(doc, obj, "version", &host->version);
+    yyjson_mut_obj_add_strbuf(doc, obj, "sku", &host->sku);
+    yyjson_mut_obj_add_strbuf(doc, obj, "vendor", &host->vendor);
+    yyjson_mut_obj_add_strbuf(doc, obj, "serial", &host->serial);
+    yyjson_mut_obj_add_strbuf(doc, obj, "uuid", &host->uuid);
+
+    return true;
+}
+
+bool ffGenerateHostJsonResult(FFHostOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    return ffModuleResultGenerateJson(&ffHostModuleInfo, options, doc, module);
 }
 
 void ffInitHostOptions(FFHostOptions* options) {
@@ -152,5 +161,17 @@ FFModuleBaseInfo ffHostModuleInfo = {
         { "Product vendor", "vendor" },
         { "Product serial number", "serial" },
         { "Product uuid", "uuid" },
-    }))
+    })),
+    .resultSize = sizeof(FFHostResult),
+    .detectResult = (void*) detectHostResult,
+    .destroyResult = (void*) destroyHostResult,
+    .printResult = (void*) printHostResult,
+    .generateJsonResultFrom = (void*) generateHostJsonResult,
+    .cacheKeys = (const FFResultCacheKey[]) {
+        { .type = FF_RESULT_CACHE_KEY_BOOT_ID }, // SMBIOS data doesn't change until reboot
+        {},
+    },
+    .serializeResult = (void*) serializeHostResult,
+    .deserializeResult = (void*) deserializeHostResult,
+    .refreshInterval = FF_MODULE_REFRESH_NEVER,
 };
@@ -1,32 +1,44 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/moduleresult.h"
 #include "common/strutil.h"
 #include "detection/packages/packages.h"
 #include "modules/packages/packages.h"
 
-bool ffPrintPackages(FFPackagesOptions* options) {
-    FFPackagesResult counts = {};
-    ffStrbufInit(&counts.pacmanBranch);
+void ffPreparePackages(FFPackagesOptions* options) {
+    if (ffModuleResultIsKept(&ffPackagesModuleInfo)) {
+        return; // The result of the previous pass is reused; the background detection would never be consumed
+    }
+    ffDetectPackagesAsync(options);
+}
+
+static const char* detectPackagesResult(FFPackagesOptions* options, FFPackagesResult* counts) {
+    ffStrbufInit(&counts->pacmanBranch);
+    return ffDetectPackages(counts, options);
+}
 
-    const char* error = ffDetectPackages(&counts, options);
+static void destroyPackagesResult(FFPackagesResult* counts) {
+    ffStrbufDestroy(&counts->pacmanBranch);
+}
 
+static bool printPackagesResult(FFPackagesOptions* options, const char* error, FFPackagesResult* counts) {
     if (error) {
         ffPrintError(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
         return false;
     }
 
-    if (counts.all == 0) {
+    if (counts->all == 0) {
         ffPrintError(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "No packages from known package managers found");
         return false;
     }
 
-    uint32_t nixAll = counts.nixDefault + counts.nixSystem + counts.nixUser;
-    uint32_t flatpakAll = counts.flatpakSystem + counts.flatpakUser;
-    uint32_t brewAll = counts.brew + counts.brewCask;
-    uint32_t guixAll = counts.guixSystem + counts.guixUser + counts.guixHome;
-    uint32_t hpkgAll = counts.hpkgSystem + counts.hpkgUser;
-    uint32_t amAll = counts.amSystem + counts.amUser;
-    uint32_t scoopAll = counts.scoopUser + counts.scoopGlobal;
+    uint32_t nixAll = counts->nixDefault + counts->nixSystem + counts->nixUser;
+    uint32_t flatpakAll = counts->flatpakSystem + counts->flatpakUser;
+    uint32_t brewAll = counts->brew + counts->brewCask;
+    uint32_t guixAll = counts->guixSystem + counts->guixUser + counts->guixHome;
+    uint32_t hpkgAll = counts->hpkgSystem + counts->hpkgUser;
+    uint32_t amAll = counts->amSystem + counts->amUser;
+    uint32_t scoopAll = counts->scoopUser + counts->scoopGlobal;
 
     if (options->moduleArgs.outputFormat.length == 0) {
         ffPrintLogoAndKey(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT);
@@ -34,8 +46,8 @@ bool ffPrintPackages(FFPackagesOptions* options) {
         FF_STRBUF_AUTO_DESTROY output = ffStrbufCreate();
 
 #define FF_PRINT_PACKAGE_NAME(var, name)           \
-    if (counts.var > 0) {                          \
-        ffStrbufAppendUInt(&output, counts.var);   \
+    if (counts->var > 0) {                          \
+        ffStrbufAppendUInt(&output, counts->var);   \
         ffStrbufAppendS(&output, " (" name "), "); \
     }
 
@@ -68,7 +80,7 @@ bool ffPrintPackages(FFPackagesOptions* options) {
         FF_PRINT_PACKAGE(eopkg)
         if (options->combined) {
             FF_PRINT_PACKAGE_ALL(flatpak);
-        } else if (counts.flatpakUser > 0) {
+        } else if (counts->flatpakUser > 0) {
             FF_PRINT_PACKAGE_NAME(flatpakSystem, "flatpak-system")
             FF_PRINT_PACKAGE_NAME(flatpakUser, "flatpak-user")
         } else {
@@ -83,7 +95,7 @@ bool ffPrintPackages(FFPackagesOptions* options) {
         }
         if (options->combined) {
             FF_PRINT_PACKAGE_ALL(hpkg)
-        } else if (counts.hpkgUser > 0) {
+        } else if (counts->hpkgUser > 0) {
             FF_PRINT_PACKAGE_NAME(hpkgSystem, "hpkg-system")
             FF_PRINT_PACKAGE_NAME(hpkgUser, "hpkg-user")
         } else {
@@ -105,11 +117,11 @@ bool ffPrintPackages(FFPackagesOptions* options) {
             FF_PRINT_PACKAGE_NAME(nixDefault, "nix-default")
         }
         FF_PRINT_PACKAGE(opkg)
-        if (counts.pacman > 0) {
-            ffStrbufAppendF(&output, "%u (pacman)", counts.pacman);
-            if (counts.pacmanBranch.length > 0) {
+        if (counts->pacman > 0) {
+            ffStrbufAppendF(&output, "%u (pacman)", counts->pacman);
+            if (counts->pacmanBranch.length > 0) {
                 ffStrbufAppendC(&output, '[');
-                ffStrbufAppend(&output, &counts.pacmanBranch);
+                ffStrbufAppend(&output, &counts->pacmanBranch);
                 ffStrbufAppendC(&output, ']');
             }
             ffStrbufAppendS(&output, ", ");
@@ -124,7 +136,7 @@ bool ffPrintPackages(FFPackagesOptions* options) {
         FF_PRINT_PACKAGE(rpm)
         if (options->combined) {
             FF_PRINT_PACKAGE_ALL(scoop);
-        } else if (counts.scoopGlobal > 0) {
+        } else if (counts->scoopGlobal > 0) {
             FF_PRINT_PACKAGE_NAME(scoopUser, "scoop-user")
             FF_PRINT_PACKAGE_NAME(scoopGlobal, "scoop-global")
         } else {
@@ -136,7 +148,7 @@ bool ffPrintPackages(FFPackagesOptions* options) {
         FF_PRINT_PACKAGE(winget)
         FF_PRINT_PACKAGE(xbps)
 
-        assert(output.length >= 2); // counts.all > 0 guarantees that at least one package count was printed, which guarantees that ", " was appended at least once
+        assert(output.length >= 2); // counts->all > 0 guarantees that at least one package count was printed, which guarantees that ", " was appended at least once
         ffStrbufSubstrBefore(&output, output.length - 1);
         output.chars[output.length - 1] = '\n';
         ffStrbufWriteTo(&output, stdout);
@@ -146,68 +158,70 @@ bool ffPrintPackages(FFPackagesOptions* options) {
             &options->moduleArgs,
             FF_PRINT_TYPE_DEFAULT,
             ((FFformatarg[]) {
-                FF_ARG(counts.amSystem, "am-system"),
-                FF_ARG(counts.amUser, "am-user"),
-                FF_ARG(counts.appimage, "appimage"),
-                FF_ARG(counts.apk, "apk"),
-                FF_ARG(counts.brew, "brew"),
-                FF_ARG(counts.brewCask, "brew-cask"),
-                FF_ARG(counts.cards, "cards"),
-                FF_ARG(counts.choco, "choco"),
-                FF_ARG(counts.dpkg, "dpkg"),
-                FF_ARG(counts.emerge, "emerge"),
-                FF_ARG(counts.eopkg, "eopkg"),
-                FF_ARG(counts.flatpakSystem, "flatpak-system"),
-                FF_ARG(counts.flatpakUser, "flatpak-user"),
-                FF_ARG(counts.guixHome, "guix-home"),
-                FF_ARG(counts.guixSystem, "guix-system"),
-                FF_ARG(counts.guixUser, "guix-user"),
-                FF_ARG(counts.hpkgSystem, "hpkg-system"),
-                FF_ARG(counts.hpkgUser, "hpkg-user"),
-                FF_ARG(counts.installrelease, "install-release"),
-                FF_ARG(counts.kiss, "kiss"),
-                FF_ARG(counts.linglong, "linglong"),
-                FF_ARG(counts.lpkg, "lpkg"),
-                FF_ARG(counts.lpkgbuild, "lpkgbuild"),
-                FF_ARG(counts.macports, "macports"),
-                FF_ARG(counts.mport, "mport"),
-                FF_ARG(counts.moss, "moss"),
-                FF_ARG(counts.nixDefault, "nix-default"),
-                FF_ARG(counts.nixSystem, "nix-system"),
-                FF_ARG(counts.nixUser, "nix-user"),
-                FF_ARG(counts.opkg, "opkg"),
-                FF_ARG(counts.pacman, "pacman"),
-                FF_ARG(counts.pacmanBranch, "pacman-branch"),
-                FF_ARG(counts.pacstall, "pacstall"),
-                FF_ARG(counts.paludis, "paludis"),
-                FF_ARG(counts.pisi, "pisi"),
-                FF_ARG(counts.pkg, "pkg"),
-                FF_ARG(counts.pkgsrc, "pkgsrc"),
-                FF_ARG(counts.pkgtool, "pkgtool"),
-                FF_ARG(counts.porg, "porg"),
-                FF_ARG(counts.rpm, "rpm"),
-                FF_ARG(counts.scoopGlobal, "scoop-global"),
-                FF_ARG(counts.scoopUser, "scoop-user"),
-                FF_ARG(counts.snap, "snap"),
-                FF_ARG(counts.soar, "soar"),
-                FF_ARG(counts.sorcery, "sorcery"),
-                FF_ARG(counts.winget, "winget"),
-                FF_ARG(counts.xbps, "xbps"),
+                FF_ARG(counts->amSystem, "am-system"),
+                FF_ARG(counts->amUser, "am-user"),
+                FF_ARG(counts->appimage, "appimage"),
+                FF_ARG(counts->apk, "apk"),
+                FF_ARG(counts->brew, "brew"),
+                FF_ARG(counts->brewCask, "brew-cask"),
+                FF_ARG(counts->cards, "cards"),
+                FF_ARG(counts->choco, "choco"),
+                FF_ARG(counts->dpkg, "dpkg"),
+                FF_ARG(counts->emerge, "emerge"),
+                FF_ARG(counts->eopkg, "eopkg"),
+                FF_ARG(counts->flatpakSystem, "flatpak-system"),
+                FF_ARG(counts->flatpakUser, "flatpak-user"),
+                FF_ARG(counts->guixHome, "guix-home"),
+                FF_ARG(counts->guixSystem, "guix-system"),
+                FF_ARG(counts->guixUser, "guix-user"),
+                FF_ARG(counts->hpkgSystem, "hpkg-system"),
+                FF_ARG(counts->hpkgUser, "hpkg-user"),
+                FF_ARG(counts->installrelease, "install-release"),
+                FF_ARG(counts->kiss, "kiss"),
+                FF_ARG(counts->linglong, "linglong"),
+                FF_ARG(counts->lpkg, "lpkg"),
+                FF_ARG(counts->lpkgbuild, "lpkgbuild"),
+                FF_ARG(counts->macports, "macports"),
+                FF_ARG(counts->mport, "mport"),
+                FF_ARG(counts->moss, "moss"),
+                FF_ARG(counts->nixDefault, "nix-default"),
+                FF_ARG(counts->nixSystem, "nix-system"),
+                FF_ARG(counts->nixUser, "nix-user"),
+                FF_ARG(counts->opkg, "opkg"),
+                FF_ARG(counts->pacman, "pacman"),
+                FF_ARG(counts->pacmanBranch, "pacman-branch"),
+                FF_ARG(counts->pacstall, "pacstall"),
+                FF_ARG(counts->paludis, "paludis"),
+                FF_ARG(counts->pisi, "pisi"),
+                FF_ARG(counts->pkg, "pkg"),
+                FF_ARG(counts->pkgsrc, "pkgsrc"),
+                FF_ARG(counts->pkgtool, "pkgtool"),
+                FF_ARG(counts->porg, "porg"),
+                FF_ARG(counts->rpm, "rpm"),
+                FF_ARG(counts->scoopGlobal, "scoop-global"),
+                FF_ARG(counts->scoopUser, "scoop-user"),
+                FF_ARG(counts->snap, "snap"),
+                FF_ARG(counts->soar, "soar"),
+                FF_ARG(counts->sorcery, "sorcery"),
+                FF_ARG(counts->winget, "winget"),
+                FF_ARG(counts->xbps, "xbps"),
 
                 FF_ARG(brewAll, "brew-all"),
                 FF_ARG(flatpakAll, "flatpak-all"),
                 FF_ARG(guixAll, "guix-all"),
                 FF_ARG(hpkgAll, "hpkg-all"),
                 FF_ARG(nixAll, "nix-all"),
-                FF_ARG(counts.all, "all"),
+                FF_ARG(counts->all, "all"),
             }));
     }
 
-    ffStrbufDestroy(&counts.pacmanBranch);
-
     return true;
 }
 
+bool ffPrintPackages(FFPackagesOptions* options) {
+    return ffModuleResultPrint(&ffPackagesModuleInfo, options);
+}
+
 void ffParsePackagesJsonObject(FFPackagesOptions* options, yyjson_val* module) {
     yyjson_val *key, *val;
     size_t idx, max;
@@ -426,12 +440,7 @@ void ffGeneratePackagesJsonConfig(FFPackagesOptions* options, yyjson_mut_doc* do
     yyjson_mut_obj_add_bool(doc, module, "combined", options->combined);
 }
 
-bool ffGeneratePackagesJsonResult(FFPackagesOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    FFPackagesResult counts = {};
-    ffStrbufInit(&counts.pacmanBranch);
-
-    const char* error = ffDetectPackages(&counts, options);
-
+static bool generatePackagesJsonResult(FF_A_UNUSED FFPackagesOptions* options, const char* error, FFPackagesResult* counts, yyjson_mut_doc* doc, yyjson_mut_val* module) {
     if (error) {
         yyjson_mut_obj_add_str(doc, module, "error", error);
         return false;
@@ -439,10 +448,10 @@ bool ffGeneratePackagesJsonResult(FFPackagesOptions* options, yyjson_mut_doc* do
 
     yyjson_mut_val* obj = yyjson_mut_obj_add_obj(doc, module, "result");
 
-    yyjson_mut_obj_add_uint(doc, obj, "all", counts.all);
+    yyjson_mut_obj_add_uint(doc, obj, "all", counts->all);
 
 #define FF_APPEND_PACKAGE_COUNT(name) \
-    if (counts.name > 0) yyjson_mut_obj_add_uint(doc, obj, #name, counts.name);
+    if (counts->name > 0) yyjson_mut_obj_add_uint(doc, obj, #name, counts->name);
     FF_APPEND_PACKAGE_COUNT(amSystem)
     FF_APPEND_PACKAGE_COUNT(amUser)
     FF_APPEND_PACKAGE_COUNT(appimage)
@@ -489,13 +498,17 @@ bool ffGeneratePackagesJsonResult(FFPackagesOptions* options, yyjson_mut_doc* do
     FF_APPEND_PACKAGE_COUNT(sorcery)
     FF_APPEND_PACKAGE_COUNT(winget)
     FF_APPEND_PACKAGE_COUNT(xbps)
-    if (counts.pacmanBranch.length > 0) {
-        yyjson_mut_obj_add_strbuf(doc, obj, "pacmanBranch", &counts.pacmanBranch);
+    if (counts->pacmanBranch.length > 0) {
+        yyjson_mut_obj_add_strbuf(doc, obj, "pacmanBranch", &counts->pacmanBranch);
     }
 
     return true;
 }
 
+bool ffGeneratePackagesJsonResult(FFPackagesOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
+    return ffModuleResultGenerateJson(&ffPackagesModuleInfo, options, doc, module);
+}
+
 void ffInitPackagesOptions(FFPackagesOptions* options) {
     ffOptionInitModuleArg(&options->moduleArgs, "󰏖");
 
@@ -573,5 +586,11 @@ FFModuleBaseInfo ffPackagesModuleInfo = {
         { "Total number of all hpkg packages", "hpkg-all" },
         { "Total number of all nix packages", "nix-all" },
         { "Number of all packages", "all" },
-    }))
+    })),
+    .resultSize = sizeof(FFPackagesResult),
+    .detectResult = (void*) detectPackagesResult,
+    .destroyResult = (void*) destroyPackagesResult,
+    .printResult = (void*) printPackagesResult,
+    .generateJsonResultFrom = (void*) generatePackagesJsonResult,
+    .refreshInterval = 60000, // Counting packages is expensive and they rarely change
 };
@@ -4,6 +4,8 @@
 
 #define FF_PACKAGES_MODULE_NAME "Packages"
 
+void ffPreparePackages(FFPackagesOptions* options);
+
 bool ffPrintPackages(FFPackagesOptions* options);
 void ffInitPackagesOptions(FFPackagesOptions* options);
 void ffDestroyPackagesOptions(FFPackagesOptions* options);
@@ -5,8 +5,8 @@
 #include "modules/processes/processes.h"
 
 bool ffPrintProcesses(FFProcessesOptions* options) {
-    uint32_t numProcesses = 0;
-    const char* error = ffDetectProcesses(&numProcesses);
+    FFProcessesResult result = {};
+    const char* error = ffDetectProcesses(&result);
 
     if (error) {
         ffPrintError(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, "%s", error);
@@ -16,9 +16,12 @@ bool ffPrintProcesses(FFProcessesOptions* options) {
     if (options->moduleArgs.outputFormat.length == 0) {
         ffPrintLogoAndKey(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT);
 
-        printf("%u\n", numProcesses);
+        printf("%u\n", result.processes);
     } else {
-        FF_PRINT_FORMAT_CHECKED(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, ((FFformatarg[]) { FF_ARG(numProcesses, "result") }));
+        FF_PRINT_FORMAT_CHECKED(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, FF_PRINT_TYPE_DEFAULT, ((FFformatarg[]) {
+            FF_ARG(result.processes, "result"),
+            FF_ARG(result.threads, "threads"),
+        }));
     }
 
     return true;
@@ -41,7 +44,7 @@ void ffGenerateProcessesJsonConfig(FFProcessesOptions* options, yyjson_mut_doc*
 }
 
 bool ffGenerateProcessesJsonResult(FF_A_UNUSED FFProcessesOptions* options, yyjson_mut_doc* doc, yyjson_mut_val* module) {
-    uint32_t result;
+    FFProcessesResult result = {};
     const char* error = ffDetectProcesses(&result);
 
     if (error) {
@@ -49,7 +52,8 @@ bool ffGenerateProcessesJsonResult(FF_A_UNUSED FFProcessesOptions* options, yyjs
         return false;
     }
 
-    yyjson_mut_obj_add_uint(doc, module, "result", result);
+    yyjson_mut_obj_add_uint(doc, module, "result", result.processes);
+    yyjson_mut_obj_add_uint(doc, module, "threads", result.threads); // Separate member: `result` stays the process count
 
     return true;
 }
@@ -72,5 +76,7 @@ FFModuleBaseInfo ffProcessesModuleInfo = {
     .generateJsonResult = (void*) ffGenerateProcessesJsonResult,
     .generateJsonConfig = (void*) ffGenerateProcessesJsonConfig,
     .formatArgs = FF_FORMAT_ARG_LIST(((FFModuleFormatArg[]) {
-        { "Process count", "result" } }))
+        { "Process count", "result" },
+        { "Thread count (0 if unknown)", "threads" },
+    }))
 };
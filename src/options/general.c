@@ -32,6 +32,8 @@ const char* ffOptionsParseGeneralJsonConfig(FFOptionsGeneral* options, yyjson_va
             }
         } else if (unsafe_yyjson_equals_str(key, "detectVersion")) {
             options->detectVersion = yyjson_get_bool(val);
+        } else if (unsafe_yyjson_equals_str(key, "resultCache")) {
+            options->resultCache = yyjson_get_bool(val);
         } else if (unsafe_yyjson_equals_str(key, "playerName")) {
             ffStrbufSetJsonVal(&options->playerName, val);
         }
@@ -70,6 +72,8 @@ bool ffOptionsParseGeneralCommandLine(FFOptionsGeneral* options, const char* key
         options->processingTimeout = ffOptionParseInt32(key, value);
     } else if (ffStrEqualsIgnCase(key, "--detect-version")) {
         options->detectVersion = ffOptionParseBoolean(value);
+    } else if (ffStrEqualsIgnCase(key, "--result-cache")) {
+        options->resultCache = ffOptionParseBoolean(value);
     } else if (ffStrEqualsIgnCase(key, "--player-name")) {
         ffOptionParseString(key, value, &options->playerName);
     }
@@ -95,6 +99,7 @@ void ffOptionsInitGeneral(FFOptionsGeneral* options) {
     options->processingTimeout = 5000;
     options->multithreading = true;
     options->detectVersion = true;
+    options->resultCache = true;
     ffStrbufInit(&options->playerName);
 
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__) || defined(__GNU__)
@@ -116,6 +121,8 @@ void ffOptionsGenerateGeneralJsonConfig(FFdata* data, FFOptionsGeneral* options)
 
     yyjson_mut_obj_add_bool(doc, obj, "detectVersion", options->detectVersion);
 
+    yyjson_mut_obj_add_bool(doc, obj, "resultCache", options->resultCache);
+
     yyjson_mut_obj_add_strbuf(doc, obj, "playerName", &options->playerName);
 
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__sun) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__) || defined(__GNU__)
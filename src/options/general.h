@@ -12,6 +12,7 @@ typedef struct FFOptionsGeneral {
     bool multithreading;
     int32_t processingTimeout;
     bool detectVersion;
+    bool resultCache;
     FFstrbuf playerName;
 
 // Module options that cannot be put in module option structure
@@ -4,18 +4,23 @@
 
 #include <stdlib.h>
 
-static void verify(const char* format, const char* arg, const char* expected, int lineNo) {
+static void verifyArgs(const char* format, uint32_t numArgs, const FFformatarg* arguments, const char* expected, int lineNo) {
     FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
     FF_STRBUF_AUTO_DESTROY formatter = ffStrbufCreateStatic(format);
-    const FFformatarg arguments[] = { { .type = FF_ARG_TYPE_STRING, arg } };
-    ffParseFormatString(&result, &formatter, 1, arguments);
+    ffParseFormatString(&result, &formatter, numArgs, arguments);
     if (!ffStrbufEqualS(&result, expected)) {
         fprintf(stderr, FASTFETCH_TEXT_MODIFIER_ERROR "[%d] %s: expected \"%s\", got \"%s\"\n" FASTFETCH_TEXT_MODIFIER_RESET, lineNo, format, expected, result.chars);
         exit(1);
     }
 }
 
+static void verify(const char* format, const char* arg, const char* expected, int lineNo) {
+    const FFformatarg arguments[] = { { .type = FF_ARG_TYPE_STRING, arg } };
+    verifyArgs(format, 1, arguments, expected, lineNo);
+}
+
 #define VERIFY(format, argument, expected) verify((format), (argument), (expected), __LINE__)
+#define VERIFY_ARGS(format, arguments, expected) verifyArgs((format), ARRAY_SIZE(arguments), (arguments), (expected), __LINE__)
 
 int main(void) {
     instance.config.display.pipe = true;
@@ -147,6 +152,67 @@ int main(void) {
         VERIFY("output({1~2})", "\e[30;47m12345\e[m", "output(\e[30;47m345\e[m)");
     }
 
+    {
+        uint32_t cores = 8;
+        bool enabled = false;
+        const FFformatarg arguments[] = {
+            { .type = FF_ARG_TYPE_STRING, .value = "Ryzen", .name = "name" },
+            { .type = FF_ARG_TYPE_UINT, .value = &cores, .name = "cores-physical" },
+            { .type = FF_ARG_TYPE_BOOL, .value = &enabled, .name = "enabled" },
+            { .type = FF_ARG_TYPE_STRING, .value = "", .name = "empty" },
+        };
+
+        VERIFY_ARGS("output({name} ({cores-physical}))", arguments, "output(Ryzen (8))");
+        VERIFY_ARGS("output({1} ({2}))", arguments, "output(Ryzen (8))");
+        VERIFY_ARGS("output({} {} {})", arguments, "output(Ryzen 8 false)");
+        VERIFY_ARGS("output({2} {})", arguments, "output(8 Ryzen)");
+        VERIFY_ARGS("output({NAME})", arguments, "output(Ryzen)");
+        VERIFY_ARGS("output({name:3}|{cores-physical<3}|{name>7}|{name|9}|{name~1,3})", arguments, "output(Ryz|8  |  Ryzen|  Ryzen  |yz)");
+
+        VERIFY_ARGS("output({?name}has {name}{?}{/empty}, no empty{/})", arguments, "output(has Ryzen, no empty)");
+        VERIFY_ARGS("output({?empty}empty{?})", arguments, "output()");
+        VERIFY_ARGS("output({?enabled}on{?}{/enabled}off{/})", arguments, "output(off)");
+        VERIFY_ARGS("output({?1}[{1}]{?}{?4}[{4}]{?}{?2}[{2}]{?})", arguments, "output([Ryzen][8])");
+
+        VERIFY_ARGS("output({unknown})", arguments, "output({unknown})");
+        VERIFY_ARGS("output({5})", arguments, "output({5})");
+        VERIFY_ARGS("output({name:x})", arguments, "output({name:x})");
+        VERIFY_ARGS("output({?unknown}x{?})", arguments, "output({?unknown}x{?})");
+        VERIFY_ARGS("output({?}{/})", arguments, "output({?}{/})");
+        VERIFY_ARGS("output({{name}})", arguments, "output({name}})");
+        VERIFY_ARGS("output({name", arguments, "output(Ryzen"); // An unclosed placeholder at the end is still evaluated
+        VERIFY_ARGS("output({unknown", arguments, "output({unknown");
+        VERIFY_ARGS("output({", arguments, "output({");
+    }
+
+    {
+        // Compiled programs are cached by format string. Names are resolved against the arguments of each call
+        uint32_t cores = 16;
+        const FFformatarg arguments1[] = {
+            { .type = FF_ARG_TYPE_STRING, .value = "Ryzen", .name = "name" },
+            { .type = FF_ARG_TYPE_UINT, .value = &cores, .name = "cores" },
+        };
+        const FFformatarg arguments2[] = {
+            { .type = FF_ARG_TYPE_UINT, .value = &cores, .name = "cores" },
+            { .type = FF_ARG_TYPE_STRING, .value = "Xeon", .name = "name" },
+        };
+        VERIFY_ARGS("cached({name} {cores})", arguments1, "cached(Ryzen 16)");
+        VERIFY_ARGS("cached({name} {cores})", arguments1, "cached(Ryzen 16)");
+        VERIFY_ARGS("cached({name} {cores})", arguments2, "cached(Xeon 16)");
+        VERIFY_ARGS("cached({1})", arguments1, "cached(Ryzen)");
+        VERIFY_ARGS("cached({1})", arguments2, "cached(16)");
+
+        // More format strings than the cache holds (`FF_FORMAT_MAX_PROGRAMS`); the rest are compiled on every call
+        char format[32], expected[32];
+        for (uint32_t round = 0; round < 2; ++round) {
+            for (uint32_t i = 0; i < 300; ++i) {
+                snprintf(format, sizeof(format), "uncached%u({name})", i);
+                snprintf(expected, sizeof(expected), "uncached%u(%s)", i, round == 0 ? "Ryzen" : "Xeon");
+                verifyArgs(format, ARRAY_SIZE(arguments1), round == 0 ? arguments1 : arguments2, expected, __LINE__);
+            }
+        }
+    }
+
 #ifndef _WIN32 // Windows doesn't have setenv
     {
         ffListInit(&instance.config.display.constants);